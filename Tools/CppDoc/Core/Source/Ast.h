@@ -18,6 +18,63 @@ class ForwardFunctionDeclaration;
 class VariableDeclaration;
 class GenericExpr;
 
+/***********************************************************************
+CppObject
+***********************************************************************/
+
+class CppObject : public Object
+{
+	template<typename T, typename Enabled>
+	friend struct vl::ReferenceCounterOperator;
+private:
+	volatile vint			counter = 0;
+
+public:
+	CppObject() { CountProfilerEvent(ProfilerCounter::CppObjectCreated); }
+	CppObject(const CppObject&) { CountProfilerEvent(ProfilerCounter::CppObjectCreated); }
+
+	CppObject&				operator=(const CppObject&) { return *this; }
+};
+
+namespace vl
+{
+	template<typename T, typename = void>
+	struct IncompleteTypeTest
+	{
+		typedef YesType						YesNoType;
+	};
+
+	template<typename T>
+	struct IncompleteTypeTest<T, decltype(void(sizeof(T)))>
+	{
+		typedef NoType						YesNoType;
+	};
+
+	// which counter Ptr<T> uses is decided by whether T derives from CppObject, which cannot be told for an incomplete T
+	// using the default counter on an AST node makes two Ptr<T> disagree on the counter, so it is rejected
+	template<typename T>
+	struct ReferenceCounterOperator<T, typename IncompleteTypeTest<T>::YesNoType>
+	{
+		static_assert(sizeof(T*) == 0, "Ptr<T> cannot create or delete a T before T is defined.");
+	};
+
+	// AST nodes and symbols carry their own reference counter, so that creating a node does not allocate another counter
+	// a raw pointer to a node could be converted to Ptr<T> again, so parser functions take raw pointers when they don't keep the node
+	template<typename T>
+	struct ReferenceCounterOperator<T, typename PointerConvertable<T, CppObject>::YesNoType>
+	{
+		static __forceinline volatile vint* CreateCounter(T* reference)
+		{
+			return &static_cast<CppObject*>(reference)->counter;
+		}
+
+		static __forceinline void DeleteReference(volatile vint* counter, void* reference)
+		{
+			delete (T*)reference;
+		}
+	};
+}
+
 /***********************************************************************
 Symbol
 ***********************************************************************/
@@ -42,7 +99,7 @@ struct CppName
 	operator bool()const { return name.Length() != 0; }
 };
 
-class Resolving : public Object
+class Resolving : public CppObject
 {
 public:
 	List<Symbol*>			resolvedSymbols;
@@ -53,7 +110,7 @@ AST
 ***********************************************************************/
 
 class IDeclarationVisitor;
-class Declaration : public Object
+class Declaration : public CppObject
 {
 public:
 	CppName					name;
@@ -64,21 +121,21 @@ public:
 };
 
 class ITypeVisitor;
-class Type : public Object
+class Type : public CppObject
 {
 public:
 	virtual void			Accept(ITypeVisitor* visitor) = 0;
 };
 
 class IExprVisitor;
-class Expr : public Object
+class Expr : public CppObject
 {
 public:
 	virtual void			Accept(IExprVisitor* visitor) = 0;
 };
 
 class IStatVisitor;
-class Stat : public Object
+class Stat : public CppObject
 {
 public:
 	Symbol*					symbol = nullptr;
@@ -86,7 +143,7 @@ public:
 	virtual void			Accept(IStatVisitor* visitor) = 0;
 };
 
-class Program : public Object
+class Program : public CppObject
 {
 public:
 	vint					createdForwardDeclByCStyleTypeReference = 0;
@@ -127,14 +184,14 @@ enum class CppInitializerType
 	Universal,
 };
 
-class Initializer : public Object
+class Initializer : public CppObject
 {
 public:
 	CppInitializerType							initializerType;
 	VariadicList<Ptr<Expr>>						arguments;
 };
 
-class Declarator : public Object
+class Declarator : public CppObject
 {
 public:
 	Ptr<symbol_component::ClassMemberCache>		classMemberCache;
@@ -197,6 +254,7 @@ struct TypeToTsysConfig
 extern bool					IsSameResolvedExpr(Ptr<Expr> e1, Ptr<Expr> e2, Dictionary<WString, WString>& equivalentNames);
 extern bool					IsSameResolvedType(Ptr<Type> t1, Ptr<Type> t2, Dictionary<WString, WString>& equivalentNames);
 extern bool					IsCompatibleFunctionDeclInSameScope(Ptr<ForwardFunctionDeclaration> declNew, Ptr<ForwardFunctionDeclaration> declOld);
+extern vuint					GetFunctionSignatureInSameScope(Ptr<ForwardFunctionDeclaration> decl);
 extern bool					IsPendingType(Type* type);
 extern bool					IsPendingType(Ptr<Type> type);
 extern ITsys*				ResolvePendingType(const ParsingArguments& pa, Ptr<Type> type, ExprTsysItem target);
@@ -55,7 +55,7 @@ enum class CppTemplateArgumentType
 	Value,				// type(value type), expr(default value)
 };
 
-class TemplateSpec : public Object
+class TemplateSpec : public CppObject
 {
 public:
 	struct Argument
@@ -73,7 +73,7 @@ public:
 	List<Argument>									arguments;
 };
 
-class SpecializationSpec : public Object
+class SpecializationSpec : public CppObject
 {
 public:
 	VariadicList<GenericArgument>					arguments;
@@ -135,6 +135,7 @@ public:
 	bool											decoratorDefault = false;
 	bool											decoratorDelete = false;
 	bool											needResolveTypeFromStatement = false;
+	vuint											signature = 0;			// cached by GetFunctionSignatureInSameScope, 0 if not computed
 };
 
 class ForwardEnumDeclaration : public Declaration
@@ -239,6 +240,7 @@ public:
 
 	List<Tuple<CppClassAccessor, Ptr<Type>>>		baseTypes;
 	List<Tuple<CppClassAccessor, Ptr<Declaration>>>	decls;
+	bool											completed = false;		// all members are parsed and special members are generated
 };
 
 /***********************************************************************
@@ -151,19 +151,23 @@ namespace symbol_totsys_impl
 	template<typename T>
 	struct VtaInput
 	{
-		List<T>&				items;
+		TsysList<T>&			items;
 		bool					isVta;
 		vint					selectedIndex = -1;
 
-		VtaInput(List<T>& _items, bool _isVta)
+		VtaInput(TsysList<T>& _items, bool _isVta)
 			:items(_items)
 			, isVta(_isVta)
 		{
 		}
 	};
 
-	template<typename T>
-	VtaInput<T> Input(List<T>& _items, bool _isVta)
+	inline VtaInput<ITsys*> Input(TypeTsysList& _items, bool _isVta)
+	{
+		return { _items,_isVta };
+	}
+
+	inline VtaInput<ExprTsysItem> Input(ExprTsysList& _items, bool _isVta)
 	{
 		return { _items,_isVta };
 	}
@@ -212,13 +216,13 @@ namespace symbol_totsys_impl
 			}
 		}
 
-		template<typename TResult, typename TProcess, typename ...TInputs>
+		template<typename TResultList, typename TProcess, typename ...TInputs>
 		struct ExpandPotentialVtaStep
 		{
 			template<vint Index>
 			struct Step
 			{
-				static void Do(const ParsingArguments& pa, List<TResult>& result, vint unboundedVtaCount, TProcess&& process, VtaInput<TInputs>& ...inputs)
+				static void Do(const ParsingArguments& pa, TResultList& result, vint unboundedVtaCount, TProcess&& process, VtaInput<TInputs>& ...inputs)
 				{
 					auto& input = Select<Index>(inputs...);
 					for (vint i = 0; i < input.items.Count(); i++)
@@ -254,7 +258,7 @@ namespace symbol_totsys_impl
 			template<>
 			struct Step<sizeof...(TInputs)>
 			{
-				static void Do(const ParsingArguments& pa, List<TResult>& result, vint unboundedVtaCount, TProcess&& process, VtaInput<TInputs>& ...inputs)
+				static void Do(const ParsingArguments& pa, TResultList& result, vint unboundedVtaCount, TProcess&& process, VtaInput<TInputs>& ...inputs)
 				{
 					if (unboundedVtaCount == -1)
 					{
@@ -279,16 +283,27 @@ namespace symbol_totsys_impl
 		};
 	}
 
-	template<typename TResult, typename TProcess, typename ...TInputs>
-	bool ExpandPotentialVtaMultiResult(const ParsingArguments& pa, List<TResult>& result, TProcess&& process, VtaInput<TInputs> ...inputs)
+	template<typename TResultList, typename TProcess, typename ...TInputs>
+	bool ExpandPotentialVtaMultiResult(const ParsingArguments& pa, TResultList& result, TProcess&& process, VtaInput<TInputs> ...inputs)
 	{
-		using Step = typename impl::ExpandPotentialVtaStep<TResult, TProcess, TInputs...>::template Step<0>;
+		CountProfilerEvent(ProfilerCounter::ExpandPotentialVta);
+
+		vint size = 1;
+		((size = symbol_type_resolving::CartesianProduct::Multiply(size, inputs.items.Count())), ...);
+		if (size > symbol_type_resolving::MaxCartesianProductSize)
+		{
+			CountProfilerEvent(ProfilerCounter::CartesianProductOverLimit);
+			AddExprTsysItemToResult(result, GetExprTsysItem(pa.tsys->Any()));
+			return (inputs.isVta || ...);
+		}
+
+		using Step = typename impl::ExpandPotentialVtaStep<TResultList, TProcess, TInputs...>::template Step<0>;
 		Step::Do(pa, result, -1, ForwardValue<TProcess&&>(process), inputs...);
 		return (inputs.isVta || ...);
 	}
 
-	template<typename TResult, typename TProcess, typename ...TInputs>
-	bool ExpandPotentialVta(const ParsingArguments& pa, List<TResult>& result, TProcess&& process, VtaInput<TInputs> ...inputs)
+	template<typename TResultList, typename TProcess, typename ...TInputs>
+	bool ExpandPotentialVta(const ParsingArguments& pa, TResultList& result, TProcess&& process, VtaInput<TInputs> ...inputs)
 	{
 		return ExpandPotentialVtaMultiResult(pa, result, [&](ExprTsysList& processResult, auto ...args)
 		{
@@ -302,59 +317,77 @@ namespace symbol_totsys_impl
 
 	namespace impl
 	{
-		template<typename TResult, typename TInput, typename TProcess>
-		void ExpandPotentialVtaList(const ParsingArguments& pa, List<TResult>& result, Array<List<TInput>>& inputs, Array<bool>& isVtas, bool isBoundedVta, vint unboundedVtaCount, Array<vint>& tsysIndex, vint level, TProcess&& process)
+		template<typename TResultList, typename TInputList, typename TProcess>
+		void ProcessPotentialVtaList(const ParsingArguments& pa, TResultList& result, Array<TInputList>& inputs, Array<bool>& isVtas, bool isBoundedVta, vint unboundedVtaCount, symbol_type_resolving::CartesianProduct& product, TProcess&& process)
 		{
-			if (level == inputs.Count())
+			SortedList<vint> boundedAnys;
+			if (isBoundedVta)
 			{
-				SortedList<vint> boundedAnys;
-				if (isBoundedVta)
+				vint paramCount = 0;
+				for (vint i = 0; i < inputs.Count(); i++)
 				{
-					vint paramCount = 0;
-					for (vint i = 0; i < inputs.Count(); i++)
+					if (isVtas[i])
 					{
-						if (isVtas[i])
+						auto tsysVta = GetExprTsysItem(inputs[i][product[i]]).tsys;
+						if (tsysVta->GetType() == TsysType::Any)
 						{
-							auto tsysVta = GetExprTsysItem(inputs[i][tsysIndex[i]]).tsys;
-							if (tsysVta->GetType() == TsysType::Any)
-							{
-								boundedAnys.Add(paramCount++);
-							}
-							else
-							{
-								paramCount += tsysVta->GetParamCount();
-							}
+							boundedAnys.Add(paramCount++);
 						}
 						else
 						{
-							paramCount++;
+							paramCount += tsysVta->GetParamCount();
 						}
 					}
+					else
+					{
+						paramCount++;
+					}
+				}
 
-					Array<ExprTsysItem> params(paramCount);
-					Array<vint> argSource(paramCount);
-					vint currentParam = 0;
+				Array<ExprTsysItem> params(paramCount);
+				Array<vint> argSource(paramCount);
+				vint currentParam = 0;
 
-					for (vint i = 0; i < inputs.Count(); i++)
+				for (vint i = 0; i < inputs.Count(); i++)
+				{
+					auto tsysItem = GetExprTsysItem(inputs[i][product[i]]);
+					if (isVtas[i] && tsysItem.tsys->GetType() != TsysType::Any)
 					{
-						auto tsysItem = GetExprTsysItem(inputs[i][tsysIndex[i]]);
-						if (isVtas[i] && tsysItem.tsys->GetType() != TsysType::Any)
+						vint paramVtaCount = tsysItem.tsys->GetParamCount();
+						for (vint j = 0; j < paramVtaCount; j++)
 						{
-							vint paramVtaCount = tsysItem.tsys->GetParamCount();
-							for (vint j = 0; j < paramVtaCount; j++)
-							{
-								params[currentParam] = { tsysItem.tsys->GetInit().headers[j], tsysItem.tsys->GetParam(j) };
-								argSource[currentParam] = i;
-								currentParam++;
-							}
-						}
-						else
-						{
-							params[currentParam] = tsysItem;
+							params[currentParam] = { tsysItem.tsys->GetInit().headers[j], tsysItem.tsys->GetParam(j) };
 							argSource[currentParam] = i;
 							currentParam++;
 						}
 					}
+					else
+					{
+						params[currentParam] = tsysItem;
+						argSource[currentParam] = i;
+						currentParam++;
+					}
+				}
+
+				ExprTsysList processResult;
+				process(processResult, params, -1, argSource, boundedAnys);
+				AddExprTsysListToResult(result, processResult);
+			}
+			else
+			{
+				Array<vint> argSource(inputs.Count());
+				for (vint i = 0; i < inputs.Count(); i++)
+				{
+					argSource[i] = i;
+				}
+
+				if (unboundedVtaCount == -1)
+				{
+					Array<ExprTsysItem> params(inputs.Count());
+					for (vint j = 0; j < inputs.Count(); j++)
+					{
+						params[j] = GetExprTsysItem(inputs[j][product[j]]);
+					}
 
 					ExprTsysList processResult;
 					process(processResult, params, -1, argSource, boundedAnys);
@@ -362,66 +395,37 @@ namespace symbol_totsys_impl
 				}
 				else
 				{
-					Array<vint> argSource(inputs.Count());
-					for (vint i = 0; i < inputs.Count(); i++)
-					{
-						argSource[i] = i;
-					}
-
-					if (unboundedVtaCount == -1)
+					Array<ExprTsysList> initParams(unboundedVtaCount);
+					for (vint i = 0; i < unboundedVtaCount; i++)
 					{
 						Array<ExprTsysItem> params(inputs.Count());
 						for (vint j = 0; j < inputs.Count(); j++)
 						{
-							params[j] = GetExprTsysItem(inputs[j][tsysIndex[j]]);
-						}
-
-						ExprTsysList processResult;
-						process(processResult, params, -1, argSource, boundedAnys);
-						AddExprTsysListToResult(result, processResult);
-					}
-					else
-					{
-						Array<ExprTsysList> initParams(unboundedVtaCount);
-						for (vint i = 0; i < unboundedVtaCount; i++)
-						{
-							Array<ExprTsysItem> params(inputs.Count());
-							for (vint j = 0; j < inputs.Count(); j++)
+							auto tsysItem = GetExprTsysItem(inputs[j][product[j]]);
+							if (isVtas[j])
 							{
-								auto tsysItem = GetExprTsysItem(inputs[j][tsysIndex[j]]);
-								if (isVtas[j])
-								{
-									params[j] = { tsysItem.tsys->GetInit().headers[i], tsysItem.tsys->GetParam(i) };
-								}
-								else
-								{
-									params[j] = tsysItem;
-								}
+								params[j] = { tsysItem.tsys->GetInit().headers[i], tsysItem.tsys->GetParam(i) };
+							}
+							else
+							{
+								params[j] = tsysItem;
 							}
-							process(initParams[i], params, i, argSource, boundedAnys);
 						}
-
-						ExprTsysList processResult;
-						symbol_type_resolving::CreateUniversalInitializerType(pa, initParams, processResult);
-						AddExprTsysListToResult(result, processResult);
+						process(initParams[i], params, i, argSource, boundedAnys);
 					}
-				}
-			}
-			else
-			{
-				vint levelCount = inputs[level].Count();
-				for (vint i = 0; i < levelCount; i++)
-				{
-					tsysIndex[level] = i;
-					ExpandPotentialVtaList<TResult, TInput, TProcess>(pa, result, inputs, isVtas, isBoundedVta, unboundedVtaCount, tsysIndex, level + 1, process);
+
+					ExprTsysList processResult;
+					symbol_type_resolving::CreateUniversalInitializerType(pa, initParams, processResult);
+					AddExprTsysListToResult(result, processResult);
 				}
 			}
 		}
 	}
 
-	template<typename TResult, typename TInput, typename TProcess>
-	void ExpandPotentialVtaList(const ParsingArguments& pa, List<TResult>& result, Array<List<TInput>>& inputs, Array<bool>& isVtas, bool isBoundedVta, vint unboundedVtaCount, TProcess&& process)
+	template<typename TResultList, typename TInputList, typename TProcess>
+	void ExpandPotentialVtaList(const ParsingArguments& pa, TResultList& result, Array<TInputList>& inputs, Array<bool>& isVtas, bool isBoundedVta, vint unboundedVtaCount, TProcess&& process)
 	{
+		CountProfilerEvent(ProfilerCounter::ExpandPotentialVta);
 		if (!isBoundedVta)
 		{
 			for (vint i = 0; i < inputs.Count(); i++)
@@ -440,20 +444,26 @@ namespace symbol_totsys_impl
 			}
 		}
 
-		Array<vint> tsysIndex(inputs.Count());
-		if (inputs.Count() > 0)
+		symbol_type_resolving::CartesianProduct product(inputs);
+		if (product.IsOverLimit())
+		{
+			CountProfilerEvent(ProfilerCounter::CartesianProductOverLimit);
+			AddExprTsysItemToResult(result, GetExprTsysItem(pa.tsys->Any()));
+			return;
+		}
+
+		while (product.Next())
 		{
-			memset(&tsysIndex[0], 0, sizeof(vint) * inputs.Count());
+			impl::ProcessPotentialVtaList(pa, result, inputs, isVtas, isBoundedVta, unboundedVtaCount, product, process);
 		}
-		impl::ExpandPotentialVtaList(pa, result, inputs, isVtas, isBoundedVta, unboundedVtaCount, tsysIndex, 0, process);
 	}
 
 	//////////////////////////////////////////////////////////////////////////////////////
 	// CheckVta
 	//////////////////////////////////////////////////////////////////////////////////////
 
-	template<typename TExpr, typename TInput>
-	bool CheckVta(const VariadicList<TExpr>& arguments, Array<List<TInput>>& inputs, Array<bool>& isVtas, vint offset, bool& hasBoundedVta, vint& unboundedVtaCount)
+	template<typename TExpr, typename TInputList>
+	bool CheckVta(const VariadicList<TExpr>& arguments, Array<TInputList>& inputs, Array<bool>& isVtas, vint offset, bool& hasBoundedVta, vint& unboundedVtaCount)
 	{
 		bool hasUnboundedVta = false;
 		for (vint i = 0; i < offset; i++)
@@ -523,7 +533,7 @@ namespace symbol_totsys_impl
 	private:
 		const ParsingArguments&		pa;
 
-		Array<List<TInput>>			argItems;
+		Array<TsysList<TInput>>		argItems;
 		Array<bool>					isVtas;
 		bool						hasBoundedVta = false;
 		vint						unboundedVtaCount = -1;
@@ -607,8 +617,8 @@ namespace symbol_totsys_impl
 			}
 		}
 
-		template<typename TItem, typename TResult, typename TProcess>
-		bool Expand(const VariadicList<TItem>* variadicList, List<TResult>& result, TProcess&& process)
+		template<typename TItem, typename TResultList, typename TProcess>
+		bool Expand(const VariadicList<TItem>* variadicList, TResultList& result, TProcess&& process)
 		{
 			bool isVta = CheckVta(
 				*variadicList,
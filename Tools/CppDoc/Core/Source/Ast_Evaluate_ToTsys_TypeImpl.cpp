@@ -93,7 +93,7 @@ namespace symbol_totsys_impl
 	{
 		if (arg.tsys->GetType() == TsysType::Array)
 		{
-			return arg.tsys->GetElement()->ArrayOf(arg.tsys->GetParamCount() + 1);
+			return arg.tsys->GetElement()->ArrayOf(arg.tsys->GetArrayDimensions() + 1);
 		}
 		else
 		{
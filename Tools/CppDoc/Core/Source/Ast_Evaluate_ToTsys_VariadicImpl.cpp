@@ -55,13 +55,13 @@ namespace symbol_totsys_impl
 		auto type = args[0].tsys;
 		if (type->GetType() == TsysType::Array)
 		{
-			if (type->GetParamCount() == 1)
+			if (type->GetArrayDimensions() == 1)
 			{
 				AddTempValue(result, type->GetElement()->PtrOf());
 			}
 			else
 			{
-				AddTempValue(result, type->GetElement()->ArrayOf(type->GetParamCount() - 1)->PtrOf());
+				AddTempValue(result, type->GetElement()->ArrayOf(type->GetArrayDimensions() - 1)->PtrOf());
 			}
 		}
 		else
@@ -80,33 +80,29 @@ namespace symbol_type_resolving
 	CreateUniversalInitializerType: Create init types from element types
 	***********************************************************************/
 
-	void CreateUniversalInitializerType(const ParsingArguments& pa, Array<ExprTsysList>& argTypesList, Array<vint>& indices, vint index, ExprTsysList& result)
+	vint MaxCartesianProductSize = 4096;
+
+	void CreateUniversalInitializerType(const ParsingArguments& pa, Array<ExprTsysList>& argTypesList, ExprTsysList& result)
 	{
-		if (index == argTypesList.Count())
+		CartesianProduct product(argTypesList);
+		if (product.IsOverLimit())
 		{
-			Array<ExprTsysItem> params(index);
-			for (vint i = 0; i < index; i++)
-			{
-				params[i] = argTypesList[i][indices[i]];
-			}
-			AddInternal(result, { nullptr,ExprTsysType::PRValue,pa.tsys->InitOf(params) });
+			CountProfilerEvent(ProfilerCounter::CartesianProductOverLimit);
+			AddInternal(result, { nullptr,ExprTsysType::PRValue,pa.tsys->Any() });
+			return;
 		}
-		else
+
+		Array<ExprTsysItem> params(argTypesList.Count());
+		while (product.Next())
 		{
-			for (vint i = 0; i < argTypesList[index].Count(); i++)
+			for (vint i = 0; i < params.Count(); i++)
 			{
-				indices[index] = i;
-				CreateUniversalInitializerType(pa, argTypesList, indices, index + 1, result);
+				params[i] = argTypesList[i][product[i]];
 			}
+			AddInternal(result, { nullptr,ExprTsysType::PRValue,pa.tsys->InitOf(params) });
 		}
 	}
 
-	void CreateUniversalInitializerType(const ParsingArguments& pa, Array<ExprTsysList>& argTypesList, ExprTsysList& result)
-	{
-		Array<vint> indices(argTypesList.Count());
-		CreateUniversalInitializerType(pa, argTypesList, indices, 0, result);
-	}
-
 	/***********************************************************************
 	CalculateValueFieldType: Given thisItem, fill the field type fo ExprTsysList
 		Value: t.f
@@ -58,6 +58,104 @@ namespace symbol_type_resolving
 		return isStatic;
 	}
 
+	/***********************************************************************
+	CartesianProduct: Enumerate combinations of candidate types lazily
+	***********************************************************************/
+
+	// when arguments have more combinations of candidate types than this, the result degrades to any_t
+	extern vint									MaxCartesianProductSize;
+
+	// combinations are enumerated in the order of nested loops, the last axis changes first
+	// duplicated items in an axis are skipped, so that the same combination is not enumerated twice
+	class CartesianProduct
+	{
+	protected:
+		Array<vint>								counts;				// number of distinct items in each axis
+		Array<vint>								offsets;			// start of each axis in distinctPositions, -1 if all items in the axis are distinct
+		List<vint>								distinctPositions;
+		Array<vint>								indices;
+		vint									size = 1;			// number of combinations, saturated at MaxCartesianProductSize + 1
+		bool									started = false;
+
+	public:
+		template<typename TList>
+		CartesianProduct(Array<TList>& axes)
+			:counts(axes.Count())
+			, offsets(axes.Count())
+			, indices(axes.Count())
+		{
+			for (vint axis = 0; axis < axes.Count(); axis++)
+			{
+				auto& items = axes[axis];
+				vint count = 0;
+				for (vint i = 0; i < items.Count(); i++)
+				{
+					if (items.IndexOf(items[i]) == i)
+					{
+						count++;
+					}
+				}
+
+				offsets[axis] = -1;
+				if (count != items.Count())
+				{
+					offsets[axis] = distinctPositions.Count();
+					for (vint i = 0; i < items.Count(); i++)
+					{
+						if (items.IndexOf(items[i]) == i)
+						{
+							distinctPositions.Add(i);
+						}
+					}
+				}
+
+				counts[axis] = count;
+				indices[axis] = 0;
+				size = Multiply(size, count);
+			}
+		}
+
+		static vint Multiply(vint size, vint count)
+		{
+			if (size == 0 || count == 0) return 0;
+			if (size > MaxCartesianProductSize / count) return MaxCartesianProductSize + 1;
+			return size * count;
+		}
+
+		vint GetSize()const
+		{
+			return size;
+		}
+
+		bool IsOverLimit()const
+		{
+			return size > MaxCartesianProductSize;
+		}
+
+		bool Next()
+		{
+			if (size == 0) return false;
+			if (!started)
+			{
+				started = true;
+				return true;
+			}
+
+			for (vint axis = indices.Count() - 1; axis >= 0; axis--)
+			{
+				if (++indices[axis] < counts[axis]) return true;
+				indices[axis] = 0;
+			}
+			return false;
+		}
+
+		vint operator[](vint axis)const
+		{
+			vint index = indices[axis];
+			return offsets[axis] == -1 ? index : distinctPositions[offsets[axis] + index];
+		}
+	};
+
 	extern bool									AddInternal(ExprTsysList& list, const ExprTsysItem& item);
 	extern void									AddInternal(ExprTsysList& list, ExprTsysList& items);
 	extern bool									AddVar(ExprTsysList& list, const ExprTsysItem& item);
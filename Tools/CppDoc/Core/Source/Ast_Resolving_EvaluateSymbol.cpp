@@ -19,24 +19,26 @@ namespace symbol_type_resolving
 					throw L"Missing TemplateArgumentContext for EvaluationKind::Instantiated";
 				}
 
-				symbol_component::SG_Cache cacheKey;
-				cacheKey.parentDeclTypeAndParams = MakePtr<Array<ITsys*>>(spec->arguments.Count() + 1);
-				cacheKey.parentDeclTypeAndParams->Set(0, pa.parentDeclType);
-				for (vint i = 0; i < spec->arguments.Count(); i++)
+				// most templates have only a few arguments, the key is built on the stack for them
+				const vint InlineKeyCount = 8;
+				ITsys* inlineKey[InlineKeyCount];
+				Array<ITsys*> heapKey;
+
+				vint keyCount = spec->arguments.Count() + 1;
+				ITsys** cacheKey = inlineKey;
+				if (keyCount > InlineKeyCount)
 				{
-					auto key = GetTemplateArgumentKey(spec->arguments[i], pa.tsys.Obj());
-					cacheKey.parentDeclTypeAndParams->Set(i + 1, argumentsToApply->arguments[key]);
+					heapKey.Resize(keyCount);
+					cacheKey = &heapKey[0];
 				}
 
-				vint index = decl->symbol->genericCaches.IndexOf(cacheKey);
-				if (index != -1)
+				cacheKey[0] = pa.parentDeclType;
+				for (vint i = 0; i < spec->arguments.Count(); i++)
 				{
-					return *decl->symbol->genericCaches[index].cachedEvaluation.Obj();
+					auto key = GetTemplateArgumentKey(spec->arguments[i], pa.tsys.Obj());
+					cacheKey[i + 1] = argumentsToApply->arguments[key];
 				}
-
-				cacheKey.cachedEvaluation = MakePtr<symbol_component::Evaluation>();
-				decl->symbol->genericCaches.Add(cacheKey);
-				return *cacheKey.cachedEvaluation.Obj();
+				return decl->symbol->genericCache.GetOrAdd(cacheKey, keyCount);
 			}
 		default:
 			{
@@ -481,6 +483,7 @@ namespace symbol_type_resolving
 		TemplateArgumentContext* argumentsToApply
 	)
 	{
+		CountProfilerEvent(ProfilerCounter::EvaluateClassSymbol);
 		EvaluateForwardClassSymbol(invokerPa, classDecl, parentDeclType, argumentsToApply);
 		auto eval = ProcessArguments(invokerPa, classDecl, classDecl->templateSpec, parentDeclType, argumentsToApply);
 		if (eval.ev.progress == symbol_component::EvaluationProgress::Evaluated)
@@ -538,6 +538,7 @@ namespace symbol_type_resolving
 
 	void InferFunctionType(const ParsingArguments& pa, ExprTsysList& inferredFunctionTypes, ExprTsysItem functionItem, Array<ExprTsysItem>& argTypes, SortedList<vint>& boundedAnys)
 	{
+		CountProfilerEvent(ProfilerCounter::InferFunctionType);
 		switch (functionItem.tsys->GetType())
 		{
 		case TsysType::Function:
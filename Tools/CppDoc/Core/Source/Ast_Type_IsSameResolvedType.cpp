@@ -592,6 +592,27 @@ bool IsCompatibleTemplateSpec(Ptr<TemplateSpec> specNew, Ptr<TemplateSpec> specO
 	return !specNew && !specOld;
 }
 
+Ptr<FunctionType> GetFunctionTypeOfDecl(Ptr<ForwardFunctionDeclaration> decl)
+{
+	auto type = decl->type;
+	while (true)
+	{
+		if (auto memberType = type.Cast<MemberType>())
+		{
+			type = memberType->type;
+		}
+		else if (auto ccType = type.Cast<CallingConventionType>())
+		{
+			type = ccType->type;
+		}
+		else
+		{
+			break;
+		}
+	}
+	return type.Cast<FunctionType>();
+}
+
 bool IsCompatibleFunctionDeclInSameScope(Ptr<ForwardFunctionDeclaration> declNew, Ptr<ForwardFunctionDeclaration> declOld)
 {
 	if (declNew->name.name != declOld->name.name) return false;
@@ -614,43 +635,8 @@ bool IsCompatibleFunctionDeclInSameScope(Ptr<ForwardFunctionDeclaration> declNew
 		}
 	}
 
-	auto typeNew = declNew->type;
-	auto typeOld = declOld->type;
-
-	while (true)
-	{
-		if (auto memberType = typeNew.Cast<MemberType>())
-		{
-			typeNew = memberType->type;
-		}
-		else if (auto ccType = typeNew.Cast<CallingConventionType>())
-		{
-			typeNew = ccType->type;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	while (true)
-	{
-		if (auto memberType = typeOld.Cast<MemberType>())
-		{
-			typeOld = memberType->type;
-		}
-		else if (auto ccType = typeOld.Cast<CallingConventionType>())
-		{
-			typeOld = ccType->type;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	auto funcNew = typeNew.Cast<FunctionType>();
-	auto funcOld = typeOld.Cast<FunctionType>();
+	auto funcNew = GetFunctionTypeOfDecl(declNew);
+	auto funcOld = GetFunctionTypeOfDecl(declOld);
 	if (!funcNew || !funcOld)
 	{
 		return false;
@@ -683,4 +669,197 @@ bool IsCompatibleFunctionDeclInSameScope(Ptr<ForwardFunctionDeclaration> declNew
 		return false;
 	}
 	return true;
+}
+
+/***********************************************************************
+GetFunctionSignatureInSameScope
+***********************************************************************/
+
+vuint SignatureOfType(Ptr<Type> type, Dictionary<WString, WString>& canonicalNames);
+
+vuint SignatureOfFunctionType(FunctionType* self, Dictionary<WString, WString>& canonicalNames)
+{
+	vuint hash = (vuint)self->parameters.Count();
+	hash = HashCombine(hash, (vuint)self->qualifierConstExpr);
+	hash = HashCombine(hash, (vuint)self->qualifierConst);
+	hash = HashCombine(hash, (vuint)self->qualifierVolatile);
+	hash = HashCombine(hash, (vuint)self->qualifierLRef);
+	hash = HashCombine(hash, (vuint)self->qualifierRRef);
+	hash = HashCombine(hash, SignatureOfType(self->returnType, canonicalNames));
+	hash = HashCombine(hash, SignatureOfType(self->decoratorReturnType, canonicalNames));
+	for (vint i = 0; i < self->parameters.Count(); i++)
+	{
+		hash = HashCombine(hash, (vuint)self->parameters[i].isVariadic);
+		hash = HashCombine(hash, SignatureOfType(self->parameters[i].item->type, canonicalNames));
+	}
+	return hash;
+}
+
+// Everything that IsSameResolvedTypeVisitor treats as identical must have the same signature
+//   names that could be renamed between declarations are replaced by their canonical names
+//   IdType and ChildType are only hashed by names, because they could match each other
+//   expressions are not hashed, because their names are resolved differently
+class SignatureOfTypeVisitor : public Object, public virtual ITypeVisitor
+{
+public:
+	vuint								result = 0;
+	Dictionary<WString, WString>&		canonicalNames;
+
+	SignatureOfTypeVisitor(Dictionary<WString, WString>& _canonicalNames)
+		:canonicalNames(_canonicalNames)
+	{
+	}
+
+	void Visit(PrimitiveType* self)override
+	{
+		result = HashCombine(HashCombine(1, (vuint)self->prefix), (vuint)self->primitive);
+	}
+
+	void Visit(ReferenceType* self)override
+	{
+		result = HashCombine(HashCombine(2, (vuint)self->reference), SignatureOfType(self->type, canonicalNames));
+	}
+
+	void Visit(ArrayType* self)override
+	{
+		result = HashCombine(3, SignatureOfType(self->type, canonicalNames));
+	}
+
+	void Visit(CallingConventionType* self)override
+	{
+		result = HashCombine(HashCombine(4, (vuint)self->callingConvention), SignatureOfType(self->type, canonicalNames));
+	}
+
+	void Visit(FunctionType* self)override
+	{
+		result = HashCombine(5, SignatureOfFunctionType(self, canonicalNames));
+	}
+
+	void Visit(MemberType* self)override
+	{
+		result = HashCombine(HashCombine(6, SignatureOfType(self->classType, canonicalNames)), SignatureOfType(self->type, canonicalNames));
+	}
+
+	void Visit(DeclType* self)override
+	{
+		result = HashCombine(7, (vuint)(self->expr != nullptr));
+	}
+
+	void Visit(DecorateType* self)override
+	{
+		result = HashCombine(HashCombine(HashCombine(8, (vuint)self->isConst), (vuint)self->isVolatile), SignatureOfType(self->type, canonicalNames));
+	}
+
+	void Visit(RootType* self)override
+	{
+		result = 9;
+	}
+
+	void Visit(IdType* self)override
+	{
+		vint index = canonicalNames.Keys().IndexOf(self->name.name);
+		result = HashCombine(10, HashString(index == -1 ? self->name.name : canonicalNames.Values()[index]));
+	}
+
+	void Visit(ChildType* self)override
+	{
+		result = HashCombine(10, HashString(self->name.name));
+	}
+
+	void Visit(GenericType* self)override
+	{
+		result = HashCombine(HashCombine(11, SignatureOfType(self->type, canonicalNames)), (vuint)self->arguments.Count());
+		for (vint i = 0; i < self->arguments.Count(); i++)
+		{
+			auto& argument = self->arguments[i];
+			result = HashCombine(result, (vuint)argument.isVariadic);
+			result = HashCombine(result, argument.item.type ? SignatureOfType(argument.item.type, canonicalNames) : 12);
+		}
+	}
+};
+
+vuint SignatureOfType(Ptr<Type> type, Dictionary<WString, WString>& canonicalNames)
+{
+	if (!type) return 0;
+	SignatureOfTypeVisitor visitor(canonicalNames);
+	type->Accept(&visitor);
+	return visitor.result;
+}
+
+// names of template arguments in the same position are equivalent, so all of them are replaced by "$"
+// names are registered in the same order as IsCompatibleTemplateSpec, which decides how types of value arguments are compared
+vuint SignatureOfTemplateSpec(Ptr<TemplateSpec> spec, Dictionary<WString, WString>& canonicalNames)
+{
+	if (!spec) return 0;
+	vuint hash = (vuint)spec->arguments.Count() + 1;
+	for (vint i = 0; i < spec->arguments.Count(); i++)
+	{
+		const auto& arg = spec->arguments[i];
+		hash = HashCombine(hash, (vuint)arg.argumentType);
+		hash = HashCombine(hash, (vuint)arg.ellipsis);
+
+		if (arg.name)
+		{
+			canonicalNames.Set(arg.name.name, L"$");
+		}
+
+		switch (arg.argumentType)
+		{
+		case CppTemplateArgumentType::HighLevelType:
+			hash = HashCombine(hash, SignatureOfTemplateSpec(arg.templateSpec, canonicalNames));
+			break;
+		case CppTemplateArgumentType::Value:
+			hash = HashCombine(hash, SignatureOfType(arg.type, canonicalNames));
+			break;
+		}
+	}
+	return hash;
+}
+
+// a template argument of the containing class could be renamed in a member function defined outside of the class
+// IsCompatibleFunctionDeclInSameScope maps it to the name used in the class, so that name is the canonical name
+void RegisterClassSpecNames(Ptr<TemplateSpec> spec, Ptr<TemplateSpec> classSpec, Dictionary<WString, WString>& canonicalNames)
+{
+	if (!spec || !classSpec) return;
+	for (vint i = 0; i < spec->arguments.Count() && i < classSpec->arguments.Count(); i++)
+	{
+		const auto& arg = spec->arguments[i];
+		const auto& classArg = classSpec->arguments[i];
+		if (arg.name && classArg.name)
+		{
+			canonicalNames.Set(arg.name.name, classArg.name.name);
+		}
+		if (arg.argumentType == CppTemplateArgumentType::HighLevelType)
+		{
+			RegisterClassSpecNames(arg.templateSpec, classArg.templateSpec, canonicalNames);
+		}
+	}
+}
+
+// If IsCompatibleFunctionDeclInSameScope(a, b) returns true, a and b have the same signature
+// The signature is cached in the declaration
+vuint GetFunctionSignatureInSameScope(Ptr<ForwardFunctionDeclaration> decl)
+{
+	if (decl->signature != 0) return decl->signature;
+
+	Dictionary<WString, WString> canonicalNames;
+	vuint hash = HashString(decl->name.name);
+	hash = HashCombine(hash, (vuint)decl->methodType);
+	hash = HashCombine(hash, SignatureOfTemplateSpec(decl->templateSpec, canonicalNames));
+	if (auto funcDecl = decl.Cast<FunctionDeclaration>())
+	{
+		for (vint i = 0; i < funcDecl->classSpecs.Count(); i++)
+		{
+			RegisterClassSpecNames(funcDecl->classSpecs[i].f0, funcDecl->classSpecs[i].f1->templateSpec, canonicalNames);
+		}
+	}
+
+	if (auto funcType = GetFunctionTypeOfDecl(decl))
+	{
+		hash = HashCombine(hash, SignatureOfFunctionType(funcType.Obj(), canonicalNames));
+	}
+
+	// 0 means the signature is not computed yet
+	decl->signature = hash == 0 ? 1 : hash;
+	return decl->signature;
 }
\ No newline at end of file
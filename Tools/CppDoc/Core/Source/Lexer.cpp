@@ -1,10 +1,10 @@
 #include "Lexer.h"
 
 /***********************************************************************
-CreateCppLexer
+CreateCppRegexLexer
 ***********************************************************************/
 
-Ptr<RegexLexer> CreateCppLexer()
+Ptr<RegexLexer> CreateCppRegexLexer()
 {
 	struct ThisShouldNotHappen {};
 
@@ -20,92 +20,709 @@ Ptr<RegexLexer> CreateCppLexer()
 }
 
 /***********************************************************************
-CppTokenCursor
+CreateCppLexer
 ***********************************************************************/
 
-CppTokenCursor::CppTokenCursor(CppTokenReader* _reader, RegexToken _token)
-	:reader(_reader)
-	, token(_token)
+Ptr<CppLexer> CreateCppLexer()
 {
+	return new CppLexer;
 }
 
-Ptr<CppTokenCursor> CppTokenCursor::Next()
+/***********************************************************************
+Keyword Table
+***********************************************************************/
+
+namespace cpp_lexer_impl
 {
-	if (!next)
+	// the seed is chosen so that no keyword collides, static_assert fails if a new keyword breaks it
+	constexpr vuint32_t				KeywordHashSeed = 0x811D1940;
+	constexpr vint					KeywordHashBits = 9;
+	constexpr vint					KeywordTableSize = 1 << KeywordHashBits;
+
+	constexpr vuint32_t HashKeyword(const wchar_t* reading, vint length)
 	{
-		next = reader->CreateNextToken();
+		vuint32_t hash = KeywordHashSeed;
+		for (vint i = 0; i < length; i++)
+		{
+			hash = (hash ^ (vuint32_t)reading[i]) * (vuint32_t)16777619;
+		}
+		return hash >> (32 - KeywordHashBits);
 	}
-	return next;
-}
 
-void CppTokenCursor::Clone(Ptr<CppTokenReader>& _reader, Ptr<CppTokenCursor>& _cursor)
-{
-	_reader = new CppTokenReader(*reader, reader->skipSpaceAndComment);
-	_cursor = new CppTokenCursor(_reader.Obj(), token);
+	struct KeywordEntry
+	{
+		const wchar_t*				keyword = nullptr;
+		vint						length = 0;
+		CppTokens					token = CppTokens::ID;
+	};
+
+	struct KeywordTable
+	{
+		KeywordEntry				entries[KeywordTableSize];
+		vint						maxLength = 0;
+		bool						collided = false;
+	};
 
-	auto reading = this;
-	auto writing = _cursor.Obj();
-	while (reading->next)
+	constexpr KeywordTable BuildKeywordTable()
 	{
-		reading = reading->next.Obj();
-		auto next = new CppTokenCursor(writing->reader, reading->token);
-		writing->next = next;
-		writing = next;
+		KeywordTable table{};
+#define DEFINE_KEYWORD(NAME, KEYWORD)\
+		{\
+			constexpr vint length = sizeof(L#KEYWORD) / sizeof(wchar_t) - 1;\
+			auto& entry = table.entries[HashKeyword(L#KEYWORD, length)];\
+			if (entry.keyword) table.collided = true;\
+			entry.keyword = L#KEYWORD;\
+			entry.length = length;\
+			entry.token = CppTokens::NAME;\
+			if (table.maxLength < length) table.maxLength = length;\
+		}\
+
+		CPP_KEYWORD_TOKENS(DEFINE_KEYWORD)
+#undef DEFINE_KEYWORD
+		return table;
 	}
-}
+
+	constexpr KeywordTable			keywordTable = BuildKeywordTable();
+	static_assert(!keywordTable.collided, "KeywordHashSeed needs to be changed to keep the keyword table collision free.");
 
 /***********************************************************************
-CppTokenReader
+Scanner (Characters)
 ***********************************************************************/
 
-Ptr<CppTokenCursor> CppTokenReader::CreateNextToken()
-{
-	while (tokenEnumerator->Next())
+	inline bool IsDigit(wchar_t c)
+	{
+		return L'0' <= c && c <= L'9';
+	}
+
+	inline bool IsHexDigit(wchar_t c)
+	{
+		return (L'0' <= c && c <= L'9') || (L'a' <= c && c <= L'f') || (L'A' <= c && c <= L'F');
+	}
+
+	inline bool IsIdHead(wchar_t c)
+	{
+		return (L'a' <= c && c <= L'z') || (L'A' <= c && c <= L'Z') || c == L'_';
+	}
+
+	inline bool IsIdChar(wchar_t c)
+	{
+		return IsIdHead(c) || IsDigit(c);
+	}
+
+	inline bool IsSpace(wchar_t c)
+	{
+		return c == L' ' || c == L'\t' || c == L'\r' || c == L'\n' || c == L'\v' || c == L'\f';
+	}
+
+	inline bool IsU(wchar_t c)
+	{
+		return c == L'u' || c == L'U';
+	}
+
+	inline bool IsL(wchar_t c)
+	{
+		return c == L'l' || c == L'L';
+	}
+
+/***********************************************************************
+Scanner (Block Scanning)
+***********************************************************************/
+
+	// spaces, comments and strings take most characters in a preprocessed file
+	// they are scanned by SSE2 for a whole vector of characters at a time, and the rest is scanned one character at a time
+
+#if defined VCZH_64 || defined __SSE2__ || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define CPP_LEXER_SSE2
+#endif
+
+#ifdef CPP_LEXER_SSE2
+	constexpr vint					CharsPerVector = sizeof(__m128i) / sizeof(wchar_t);
+
+	inline __m128i LoadChars(const wchar_t* reading)
+	{
+		return _mm_loadu_si128((const __m128i*)reading);
+	}
+
+	inline __m128i SplatChar(wchar_t c)
+	{
+		if constexpr (sizeof(wchar_t) == 2)
+		{
+			return _mm_set1_epi16((short)c);
+		}
+		else
+		{
+			return _mm_set1_epi32((int)c);
+		}
+	}
+
+	inline __m128i EqualChars(__m128i a, __m128i b)
+	{
+		if constexpr (sizeof(wchar_t) == 2)
+		{
+			return _mm_cmpeq_epi16(a, b);
+		}
+		else
+		{
+			return _mm_cmpeq_epi32(a, b);
+		}
+	}
+
+	// returns the index of the lowest set bit, bits should not be 0
+	inline vint FirstBit(vuint32_t bits)
+	{
+#ifdef VCZH_MSVC
+		unsigned long index = 0;
+		_BitScanForward(&index, bits);
+		return (vint)index;
+#else
+		return (vint)__builtin_ctz(bits);
+#endif
+	}
+
+	// returns the index of the highest set bit, bits should not be 0
+	inline vint LastBit(vuint32_t bits)
+	{
+#ifdef VCZH_MSVC
+		unsigned long index = 0;
+		_BitScanReverse(&index, bits);
+		return (vint)index;
+#else
+		return 31 - (vint)__builtin_clz(bits);
+#endif
+	}
+
+	// returns bits of bytes in a vector, bytes of a character are set when the character equals to any of splats
+	template<vint Count>
+	inline vuint32_t MatchCharsInVector(const wchar_t* reading, const __m128i(&splats)[Count])
+	{
+		auto block = LoadChars(reading);
+		auto mask = EqualChars(block, splats[0]);
+		for (vint i = 1; i < Count; i++)
+		{
+			mask = _mm_or_si128(mask, EqualChars(block, splats[i]));
+		}
+
+		return (vuint32_t)_mm_movemask_epi8(mask);
+	}
+#endif
+
+	// returns the first L'\0' or any character in chars, starting from reading
+	template<vint Count>
+	const wchar_t* FindChars(const wchar_t* reading, const wchar_t* end, const wchar_t(&chars)[Count])
+	{
+#ifdef CPP_LEXER_SSE2
+		__m128i splats[Count + 1];
+		splats[0] = _mm_setzero_si128();
+		for (vint i = 0; i < Count; i++)
+		{
+			splats[i + 1] = SplatChar(chars[i]);
+		}
+
+		while (end - reading >= CharsPerVector)
+		{
+			if (auto bits = MatchCharsInVector(reading, splats))
+			{
+				return reading + FirstBit(bits) / sizeof(wchar_t);
+			}
+			reading += CharsPerVector;
+		}
+#endif
+
+		for (; *reading; reading++)
+		{
+			for (vint i = 0; i < Count; i++)
+			{
+				if (*reading == chars[i]) return reading;
+			}
+		}
+		return reading;
+	}
+
+	// returns the first character that is not [ \t\r\n\v\f], starting from reading
+	const wchar_t* SkipSpaces(const wchar_t* reading, const wchar_t* end)
 	{
-		auto token = tokenEnumerator->Current();
-		if (skipSpaceAndComment)
+#ifdef CPP_LEXER_SSE2
+		const __m128i splats[] = { SplatChar(L' '), SplatChar(L'\t'), SplatChar(L'\r'), SplatChar(L'\n'), SplatChar(L'\v'), SplatChar(L'\f') };
+		const vuint32_t allBits = (1 << sizeof(__m128i)) - 1;
+
+		while (end - reading >= CharsPerVector)
 		{
-			switch ((CppTokens)token.token)
+			if (auto bits = ~MatchCharsInVector(reading, splats) & allBits)
 			{
-			case CppTokens::SPACE:
-			case CppTokens::COMMENT1:
-			case CppTokens::COMMENT2:
-				continue;
+				return reading + FirstBit(bits) / sizeof(wchar_t);
 			}
+			reading += CharsPerVector;
 		}
-		return new CppTokenCursor(this, token);
+#endif
+
+		while (IsSpace(*reading)) reading++;
+		return reading;
+	}
+
+	// returns the number of L'\n' in [reading, end), the last one is stored in lastLineBreak, or nullptr if there is none
+	vint CountLineBreaks(const wchar_t* reading, const wchar_t* end, const wchar_t*& lastLineBreak)
+	{
+		vint count = 0;
+		lastLineBreak = nullptr;
+#ifdef CPP_LEXER_SSE2
+		const __m128i splats[] = { SplatChar(L'\n') };
+
+		while (end - reading >= CharsPerVector)
+		{
+			if (auto bits = MatchCharsInVector(reading, splats))
+			{
+				lastLineBreak = reading + LastBit(bits) / sizeof(wchar_t);
+				for (; bits; bits &= bits - 1)
+				{
+					count++;
+				}
+			}
+			reading += CharsPerVector;
+		}
+		count /= sizeof(wchar_t);
+#endif
+
+		for (; reading < end; reading++)
+		{
+			if (*reading == L'\n')
+			{
+				count++;
+				lastLineBreak = reading;
+			}
+		}
+		return count;
+	}
+
+/***********************************************************************
+Scanner (Tokens)
+***********************************************************************/
+
+	// each Match function returns the length of the longest prefix accepted by the regex of that token, or 0
+	// end is where the input buffer ends, but tokens also stop at the first L'\0' like the regex lexer
+
+	// [uU]|[lL]|[uU][lL]|[lL][uU]|[lL][lL]|[uU][lL][lL]|[lL][uU][lL]|[lL][lL][uU]
+	vint MatchIntegerSuffix(const wchar_t* reading)
+	{
+		if (IsU(reading[0]))
+		{
+			if (!IsL(reading[1])) return 1;
+			return IsL(reading[2]) ? 3 : 2;
+		}
+		else if (IsL(reading[0]))
+		{
+			if (IsU(reading[1])) return IsL(reading[2]) ? 3 : 2;
+			if (IsL(reading[1])) return IsU(reading[2]) ? 3 : 2;
+			return 1;
+		}
+		return 0;
+	}
+
+	vint MatchInt(const wchar_t* reading)
+	{
+		vint length = 0;
+		while (IsDigit(reading[length])) length++;
+		if (length == 0) return 0;
+
+		while (reading[length] == L'\'' && IsDigit(reading[length + 1]))
+		{
+			length++;
+			while (IsDigit(reading[length])) length++;
+		}
+		return length + MatchIntegerSuffix(reading + length);
+	}
+
+	vint MatchPrefixedInt(const wchar_t* reading, wchar_t prefix, bool(*isDigit)(wchar_t))
+	{
+		if (reading[0] != L'0' || (reading[1] != prefix && reading[1] != prefix - L'a' + L'A')) return 0;
+		if (!isDigit(reading[2])) return 0;
+
+		vint length = 3;
+		while (isDigit(reading[length])) length++;
+		return length + MatchIntegerSuffix(reading + length);
+	}
+
+	vint MatchFloat(const wchar_t* reading)
+	{
+		vint length = 0;
+		while (IsDigit(reading[length])) length++;
+		if (reading[length] != L'.') return 0;
+		if (length == 0 && !IsDigit(reading[1])) return 0;
+
+		length++;
+		while (IsDigit(reading[length])) length++;
+
+		if (reading[length] == L'e' || reading[length] == L'E')
+		{
+			vint exponent = length + 1;
+			if (reading[exponent] == L'+' || reading[exponent] == L'-') exponent++;
+			if (IsDigit(reading[exponent]))
+			{
+				while (IsDigit(reading[exponent])) exponent++;
+				length = exponent;
+			}
+		}
+
+		switch (reading[length])
+		{
+		case L'f': case L'F': case L'l': case L'L':
+			length++;
+		}
+		return length;
+	}
+
+	// ([uUL]|u8)?QUOTE([^/\QUOTE]|/\/.)*QUOTE
+	vint MatchQuoted(const wchar_t* reading, const wchar_t* end, wchar_t quote)
+	{
+		vint length = 0;
+		if (reading[0] == L'u' && reading[1] == L'8' && reading[2] == quote) length = 2;
+		else if ((IsU(reading[0]) || reading[0] == L'L') && reading[1] == quote) length = 1;
+		else if (reading[0] != quote) return 0;
+
+		const wchar_t stops[] = { quote, L'\\' };
+		auto current = reading + length + 1;
+		while (true)
+		{
+			current = FindChars(current, end, stops);
+			if (*current == quote) return current - reading + 1;
+			if (*current == 0 || current[1] == 0) return 0;
+			current += 2;
+		}
+	}
+
+	// //*([^*]|/*+[^*//])*/*+//, which ends at the first "*/"
+	vint MatchBlockComment(const wchar_t* reading, const wchar_t* end)
+	{
+		if (reading[0] != L'/' || reading[1] != L'*') return 0;
+
+		const wchar_t stops[] = { L'*' };
+		auto current = reading + 2;
+		while (true)
+		{
+			current = FindChars(current, end, stops);
+			if (*current == 0) return 0;
+			if (current[1] == L'/') return current - reading + 2;
+			current++;
+		}
+	}
+
+	// ////[^\r\n]*
+	vint MatchLineComment(const wchar_t* reading, const wchar_t* end)
+	{
+		const wchar_t stops[] = { L'\r', L'\n' };
+		return FindChars(reading + 2, end, stops) - reading;
+	}
+
+	// returns the length of the token at reading, and 0 if the regex lexer is needed
+	vint ScanToken(const wchar_t* reading, const wchar_t* end, CppTokens& token)
+	{
+		auto c = reading[0];
+		switch (c)
+		{
+		case L'{': token = CppTokens::LBRACE; return 1;
+		case L'}': token = CppTokens::RBRACE; return 1;
+		case L'[': token = CppTokens::LBRACKET; return 1;
+		case L']': token = CppTokens::RBRACKET; return 1;
+		case L'(': token = CppTokens::LPARENTHESIS; return 1;
+		case L')': token = CppTokens::RPARENTHESIS; return 1;
+		case L'<': token = CppTokens::LT; return 1;
+		case L'>': token = CppTokens::GT; return 1;
+		case L'=': token = CppTokens::EQ; return 1;
+		case L'!': token = CppTokens::NOT; return 1;
+		case L'%': token = CppTokens::PERCENT; return 1;
+		case L':': token = CppTokens::COLON; return 1;
+		case L';': token = CppTokens::SEMICOLON; return 1;
+		case L'?': token = CppTokens::QUESTIONMARK; return 1;
+		case L',': token = CppTokens::COMMA; return 1;
+		case L'*': token = CppTokens::MUL; return 1;
+		case L'+': token = CppTokens::ADD; return 1;
+		case L'-': token = CppTokens::SUB; return 1;
+		case L'^': token = CppTokens::XOR; return 1;
+		case L'&': token = CppTokens::AND; return 1;
+		case L'|': token = CppTokens::OR; return 1;
+		case L'~': token = CppTokens::REVERT; return 1;
+		case L'#': token = CppTokens::SHARP; return 1;
+		case L'.':
+			if (vint length = MatchFloat(reading))
+			{
+				token = CppTokens::FLOAT;
+				return length;
+			}
+			token = CppTokens::DOT;
+			return 1;
+		case L'/':
+			if (reading[1] == L'/')
+			{
+				token = reading[2] == L'/' ? CppTokens::DOCUMENT : CppTokens::COMMENT1;
+				return MatchLineComment(reading, end);
+			}
+			if (vint length = MatchBlockComment(reading, end))
+			{
+				token = CppTokens::COMMENT2;
+				return length;
+			}
+			token = CppTokens::DIV;
+			return 1;
+		case L'"':
+			token = CppTokens::STRING;
+			return MatchQuoted(reading, end, L'"');
+		case L'\'':
+			token = CppTokens::CHAR;
+			return MatchQuoted(reading, end, L'\'');
+		}
+
+		if (IsDigit(c))
+		{
+			// when two tokens match the same length, the one defined first wins
+			vint length = MatchInt(reading);
+			token = CppTokens::INT;
+
+			if (c == L'0')
+			{
+				vint hex = MatchPrefixedInt(reading, L'x', &IsHexDigit);
+				if (hex > length) { length = hex; token = CppTokens::HEX; }
+				vint bin = MatchPrefixedInt(reading, L'b', [](wchar_t c) { return c == L'0' || c == L'1'; });
+				if (bin > length) { length = bin; token = CppTokens::BIN; }
+			}
+
+			vint flt = MatchFloat(reading);
+			if (flt > length) { length = flt; token = CppTokens::FLOAT; }
+			return length;
+		}
+
+		if (IsIdHead(c))
+		{
+			vint length = 1;
+			while (IsIdChar(reading[length])) length++;
+
+			if (c == L'u' || c == L'U' || c == L'L')
+			{
+				vint str = MatchQuoted(reading, end, L'"');
+				if (str > length)
+				{
+					token = CppTokens::STRING;
+					return str;
+				}
+				vint chr = MatchQuoted(reading, end, L'\'');
+				if (chr > length)
+				{
+					token = CppTokens::CHAR;
+					return chr;
+				}
+			}
+
+			token = CppLexer::ClassifyIdentifier(reading, length);
+			return length;
+		}
+
+		if (IsSpace(c))
+		{
+			token = CppTokens::SPACE;
+			return SkipSpaces(reading + 1, end) - reading;
+		}
+
+		return 0;
+	}
+}
+using namespace cpp_lexer_impl;
+
+/***********************************************************************
+CppLexer
+***********************************************************************/
+
+Ptr<RegexLexer> CppLexer::GetRegexLexer()
+{
+	SPIN_LOCK(lock)
+	{
+		if (!regexLexer)
+		{
+			regexLexer = CreateCppRegexLexer();
+		}
+		return regexLexer;
 	}
 	return nullptr;
 }
 
-CppTokenReader::CppTokenReader(const CppTokenReader& _reader, bool _skipSpaceAndComment)
-	:gotFirstToken(_reader.gotFirstToken)
-	, skipSpaceAndComment(_skipSpaceAndComment)
-	, lexer(_reader.lexer)
-	, tokens(_reader.tokens)
-	, tokenEnumerator(_reader.tokenEnumerator ? _reader.tokenEnumerator->Clone() : nullptr)
+bool CppLexer::TryParse(const WString& input, List<RegexToken>& tokens, bool(*discard)(vint))
 {
+	auto start = input.Buffer();
+	auto end = start + input.Length();
+#ifdef VCZH_GCC
+	// the regex lexer stops at characters that do not fit in UTF-16
+	for (auto reading = start; *reading; reading++)
+	{
+		if ((vuint32_t)*reading >= 65536) return false;
+	}
+#endif
+
+	vint row = 0;
+	vint column = 0;
+	auto reading = start;
+	while (*reading)
+	{
+		CppTokens tokenId;
+		vint length = ScanToken(reading, end, tokenId);
+		if (length == 0) return false;
+
+		RegexToken token;
+		token.start = reading - start;
+		token.length = length;
+		token.token = (vint)tokenId;
+		token.reading = reading;
+		token.codeIndex = -1;
+		token.completeToken = true;
+		token.rowStart = row;
+		token.columnStart = column;
+
+		// the end position is the position of the last character
+		const wchar_t* lastLineBreak = nullptr;
+		token.rowEnd = row + CountLineBreaks(reading, reading + length - 1, lastLineBreak);
+		token.columnEnd = lastLineBreak ? reading + length - 2 - lastLineBreak : column + length - 1;
+
+		if (reading[length - 1] == L'\n')
+		{
+			row = token.rowEnd + 1;
+			column = 0;
+		}
+		else
+		{
+			row = token.rowEnd;
+			column = token.columnEnd + 1;
+		}
+
+		if (!discard || !discard(token.token))
+		{
+			tokens.Add(token);
+		}
+		reading += length;
+	}
+	return true;
 }
 
-CppTokenReader::CppTokenReader(Ptr<RegexLexer> _lexer, const WString& input, bool _skipSpaceAndComment)
-	:skipSpaceAndComment(_skipSpaceAndComment)
-	, lexer(_lexer)
+CppTokens CppLexer::ClassifyIdentifier(const wchar_t* reading, vint length)
 {
-	tokens = new RegexTokens(lexer->Parse(input));
-	tokenEnumerator = tokens->CreateEnumerator();
+	if (length > keywordTable.maxLength) return CppTokens::ID;
+	auto& entry = keywordTable.entries[HashKeyword(reading, length)];
+	if (entry.length == length && memcmp(entry.keyword, reading, sizeof(wchar_t) * length) == 0)
+	{
+		return entry.token;
+	}
+	return CppTokens::ID;
 }
 
-CppTokenReader::~CppTokenReader()
+void CppLexer::Parse(const WString& input, List<RegexToken>& tokens, bool(*discard)(vint))
+{
+	vint count = tokens.Count();
+	if (!TryParse(input, tokens, discard))
+	{
+		if (tokens.Count() > count)
+		{
+			tokens.RemoveRange(count, tokens.Count() - count);
+		}
+		GetRegexLexer()->Parse(input).ReadToEnd(tokens, discard);
+	}
+}
+
+/***********************************************************************
+CppTokenCursor
+***********************************************************************/
+
+CppTokenCursor* CppTokenCursor::Next()
+{
+	auto next = this + 1;
+	return next == &buffer->cursors[0] + buffer->cursors.Count() ? nullptr : next;
+}
+
+Ptr<CppTokenBuffer> CppTokenCursor::GetBuffer()
+{
+	return buffer;
+}
+
+void CppTokenCursor::Clone(Ptr<CppTokenReader>& _reader, CppTokenCursor*& _cursor)
+{
+	// tokens are immutable, cloning only shares the buffer
+	_reader = new CppTokenReader(GetBuffer());
+	_cursor = this;
+}
+
+/***********************************************************************
+CppTokenBuffer
+***********************************************************************/
+
+bool IsSpaceOrComment(vint token)
+{
+	switch ((CppTokens)token)
+	{
+	case CppTokens::SPACE:
+	case CppTokens::COMMENT1:
+	case CppTokens::COMMENT2:
+		return true;
+	default:
+		return false;
+	}
+}
+
+CppTokenBuffer::CppTokenBuffer(Ptr<CppLexer> lexer, const WString& _input, bool skipSpaceAndComment)
+	:input(_input)
 {
-	delete tokenEnumerator;
+	List<RegexToken> tokens;
+	lexer->Parse(input, tokens, (skipSpaceAndComment ? &IsSpaceOrComment : nullptr));
+
+	for (vint i = 0; i < tokens.Count(); i++)
+	{
+		CppTokenCursor cursor;
+		cursor.buffer = this;
+		cursor.token = tokens[i];
+		cursors.Add(cursor);
+	}
 }
 
-Ptr<CppTokenCursor> CppTokenReader::GetFirstToken()
+CppTokenBuffer::CppTokenBuffer(const WString& _input, List<RegexToken>& tokens)
+	:input(_input)
 {
-	if (gotFirstToken)
+	// tokens are already lexed from _input, and they are used as is
+	for (vint i = 0; i < tokens.Count(); i++)
 	{
-		throw L"You cannot call GetFirstToken() twice.";
+		CppTokenCursor cursor;
+		cursor.buffer = this;
+		cursor.token = tokens[i];
+		cursors.Add(cursor);
 	}
-	gotFirstToken = true;
-	return CreateNextToken();
+}
+
+CppTokenCursor* CppTokenBuffer::GetFirstToken()
+{
+	return cursors.Count() == 0 ? nullptr : &cursors[0];
+}
+
+vint CppTokenBuffer::Count()
+{
+	return cursors.Count();
+}
+
+/***********************************************************************
+CppTokenReader
+***********************************************************************/
+
+CppTokenReader::CppTokenReader(Ptr<CppTokenBuffer> _buffer)
+	:buffer(_buffer)
+{
+}
+
+CppTokenReader::CppTokenReader(Ptr<CppLexer> _lexer, const WString& input, bool _skipSpaceAndComment)
+	:buffer(new CppTokenBuffer(_lexer, input, _skipSpaceAndComment))
+{
+}
+
+CppTokenReader::CppTokenReader(const WString& input, List<RegexToken>& tokens)
+	:buffer(new CppTokenBuffer(input, tokens))
+{
+}
+
+CppTokenReader::~CppTokenReader()
+{
+}
+
+CppTokenCursor* CppTokenReader::GetFirstToken()
+{
+	return buffer->GetFirstToken();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef VCZH_DOCUMENT_CPPDOC_LEXER
 #define VCZH_DOCUMENT_CPPDOC_LEXER
 
+#include <VlppOS.h>
 #include <VlppRegex.h>
 #include "LexerTokenDef.h"
 
@@ -19,48 +20,108 @@ enum class CppTokens
 #undef DEFINE_TOKEN
 };
 
-extern Ptr<RegexLexer> CreateCppLexer();
+extern Ptr<RegexLexer> CreateCppRegexLexer();
+
+/*
+CppLexer is a hand-written scanner for tokens defined in LexerTokenDef.h.
+It produces exactly the same tokens as the lexer from CreateCppRegexLexer,
+keywords are recognized from identifiers using a perfect hash table generated at compile time.
+An input with any character that does not begin a complete token is given to the regex lexer instead,
+which is only created when it is needed, so that error tokens are reported in the same way.
+*/
+
+class CppLexer : public Object
+{
+protected:
+	SpinLock					lock;
+	Ptr<RegexLexer>				regexLexer;
+
+	Ptr<RegexLexer>				GetRegexLexer();
+	bool						TryParse(const WString& input, List<RegexToken>& tokens, bool(*discard)(vint));
+public:
+	static CppTokens			ClassifyIdentifier(const wchar_t* reading, vint length);
+
+	void						Parse(const WString& input, List<RegexToken>& tokens, bool(*discard)(vint) = nullptr);
+};
+
+extern Ptr<CppLexer> CreateCppLexer();
 
 /***********************************************************************
 Reader
 ***********************************************************************/
 
 class CppTokenCursor;
+class CppTokenBuffer;
 class CppTokenReader;
 
+/*
+All tokens are lexed at once into a CppTokenBuffer.
+A CppTokenCursor is an element in this buffer, it is used as a raw pointer,
+so that moving forward, copying and backtracking cost nothing.
+*/
+
 class CppTokenCursor
 {
-	friend class CppTokenReader;
+	friend class CppTokenBuffer;
 private:
-	CppTokenReader*				reader;
-	Ptr<CppTokenCursor>			next;
+	CppTokenBuffer*				buffer = nullptr;
 
-	CppTokenCursor(CppTokenReader* _reader, RegexToken _token);
 public:
 	RegexToken					token;
 
-	Ptr<CppTokenCursor>			Next();
-	void						Clone(Ptr<CppTokenReader>& _reader, Ptr<CppTokenCursor>& _cursor);
+	CppTokenCursor*				Next();
+	Ptr<CppTokenBuffer>			GetBuffer();
+	void						Clone(Ptr<CppTokenReader>& _reader, CppTokenCursor*& _cursor);
 };
 
-class CppTokenReader : public Object
+class CppTokenBuffer : public Object
 {
 	friend class CppTokenCursor;
+	friend struct vl::ReferenceCounterOperator<CppTokenBuffer>;
 protected:
-	bool						gotFirstToken = false;
-	bool						skipSpaceAndComment = false;
-	Ptr<RegexLexer>				lexer;
-	Ptr<RegexTokens>			tokens;
-	IEnumerator<RegexToken>*	tokenEnumerator;
+	volatile vint				counter = 0;
+	WString						input;
+	List<CppTokenCursor>		cursors;
 
-	Ptr<CppTokenCursor>			CreateNextToken();
+public:
+	CppTokenBuffer(Ptr<CppLexer> lexer, const WString& _input, bool skipSpaceAndComment);
+	CppTokenBuffer(const WString& _input, List<RegexToken>& tokens);
+
+	CppTokenCursor*				GetFirstToken();
+	vint						Count();
+};
+
+namespace vl
+{
+	// CppTokenBuffer carries its own reference counter, so that a cursor could share the buffer it belongs to
+	template<>
+	struct ReferenceCounterOperator<CppTokenBuffer>
+	{
+		static __forceinline volatile vint* CreateCounter(CppTokenBuffer* reference)
+		{
+			return &reference->counter;
+		}
+
+		static __forceinline void DeleteReference(volatile vint* counter, void* reference)
+		{
+			delete (CppTokenBuffer*)reference;
+		}
+	};
+}
+
+class CppTokenReader : public Object
+{
+	friend class CppTokenCursor;
+protected:
+	Ptr<CppTokenBuffer>			buffer;
 
-	CppTokenReader(const CppTokenReader& _reader, bool _skipSpaceAndComment);
+	CppTokenReader(Ptr<CppTokenBuffer> _buffer);
 public:
-	CppTokenReader(Ptr<RegexLexer> _lexer, const WString& input, bool _skipSpaceAndComment = true);
+	CppTokenReader(Ptr<CppLexer> _lexer, const WString& input, bool _skipSpaceAndComment = true);
+	CppTokenReader(const WString& input, List<RegexToken>& tokens);
 	~CppTokenReader();
 
-	Ptr<CppTokenCursor>			GetFirstToken();
+	CppTokenCursor*				GetFirstToken();
 };
 
 #endif
\ No newline at end of file
@@ -44,6 +44,328 @@ Evaluation
 		return *extraTypeLists[index].Obj();
 	}
 
+/***********************************************************************
+SymbolGroup
+***********************************************************************/
+
+	vint SymbolGroup::Find(vuint hash, const WString& name)const
+	{
+		return buckets.Find(hash, [&](vint i)
+		{
+			auto entry = entries[i].Obj();
+			return entry->hash == hash && entry->name == name;
+		});
+	}
+
+	void SymbolGroup::SortEntries()
+	{
+		// children are enumerated in the order of names, which decides generated unique ids
+		// entries appended after the last sorting are sorted and merged into sorted ones, and entries without symbols are dropped
+		if (!sortedEntriesDirty) return;
+
+		auto compare = [&](vint a, vint b)
+		{
+			return WString::Compare(entries[a]->name, entries[b]->name);
+		};
+
+		vint count = sortedEntries.Count();
+		if (count > sortedCount)
+		{
+			SortLambda(&sortedEntries[sortedCount], count - sortedCount, compare);
+		}
+
+		List<vint> merged;
+		vint i = 0;
+		vint j = sortedCount;
+		while (i < sortedCount || j < count)
+		{
+			vint index = -1;
+			if (j == count || (i < sortedCount && compare(sortedEntries[i], sortedEntries[j]) < 0))
+			{
+				index = sortedEntries[i++];
+			}
+			else
+			{
+				index = sortedEntries[j++];
+			}
+
+			auto entry = entries[index].Obj();
+			if (entry->symbols.Count() == 0)
+			{
+				entry->listed = false;
+			}
+			else
+			{
+				merged.Add(index);
+			}
+		}
+
+		CopyFrom(sortedEntries, merged);
+		sortedCount = sortedEntries.Count();
+		sortedEntriesDirty = false;
+	}
+
+	void SymbolGroup::AddSignature(Entry* entry, vint position)
+	{
+		vuint signature = entry->signatures[position];
+		if (signature == 0)
+		{
+			if (entry->firstNonOverloadable == -1)
+			{
+				switch (entry->symbols[position]->kind)
+				{
+				case CSTYLE_TYPE_SYMBOL_KIND:
+					break;
+				default:
+					entry->firstNonOverloadable = position;
+				}
+			}
+			return;
+		}
+
+		// small overload sets are searched linearly
+		entry->functionCount++;
+		if (entry->functionCount <= 8) return;
+		if (entry->signatureBuckets.IsFull(entry->functionCount))
+		{
+			RebuildSignatures(entry);
+			return;
+		}
+		entry->signatureBuckets.Add(signature, position);
+	}
+
+	void SymbolGroup::RebuildSignatures(Entry* entry)
+	{
+		entry->functionCount = 0;
+		entry->firstNonOverloadable = -1;
+		for (vint position = 0; position < entry->signatures.Count(); position++)
+		{
+			if (entry->signatures[position] != 0)
+			{
+				entry->functionCount++;
+			}
+			else if (entry->firstNonOverloadable == -1)
+			{
+				switch (entry->symbols[position]->kind)
+				{
+				case CSTYLE_TYPE_SYMBOL_KIND:
+					break;
+				default:
+					entry->firstNonOverloadable = position;
+				}
+			}
+		}
+
+		if (entry->functionCount <= 8)
+		{
+			entry->signatureBuckets.Resize(0);
+			return;
+		}
+
+		vint bucketCount = 16;
+		while (entry->functionCount * 2 > bucketCount)
+		{
+			bucketCount *= 2;
+		}
+		entry->signatureBuckets.Resize(bucketCount);
+
+		// positions are inserted in order, so positions of the same signature are probed in order
+		for (vint position = 0; position < entry->signatures.Count(); position++)
+		{
+			vuint signature = entry->signatures[position];
+			if (signature != 0)
+			{
+				entry->signatureBuckets.Add(signature, position);
+			}
+		}
+	}
+
+	vint SymbolGroup::Count()const
+	{
+		CHECK_ERROR(!sortedEntriesDirty, L"SymbolGroup::Count()#SortEntries() must be called after adding or removing symbols.");
+		return sortedEntries.Count();
+	}
+
+	const List<Ptr<Symbol>>& SymbolGroup::GetByIndex(vint index)const
+	{
+		CHECK_ERROR(!sortedEntriesDirty, L"SymbolGroup::GetByIndex(vint)#SortEntries() must be called after adding or removing symbols.");
+		return entries[sortedEntries[index]]->symbols;
+	}
+
+	const List<Ptr<Symbol>>* SymbolGroup::TryGet(const WString& name)const
+	{
+		vint index = Find(HashString(name), name);
+		if (index == -1) return nullptr;
+
+		auto& symbols = entries[index]->symbols;
+		return symbols.Count() == 0 ? nullptr : &symbols;
+	}
+
+	vint SymbolGroup::GetFirstNonOverloadable(const WString& name)const
+	{
+		vint index = Find(HashString(name), name);
+		if (index == -1) return -1;
+		return entries[index]->firstNonOverloadable;
+	}
+
+	vint SymbolGroup::FindFunction(const WString& name, vuint signature, vint afterPosition)const
+	{
+		vint index = Find(HashString(name), name);
+		if (index == -1) return -1;
+
+		auto entry = entries[index].Obj();
+		if (entry->signatureBuckets.Count() == 0)
+		{
+			for (vint position = afterPosition + 1; position < entry->signatures.Count(); position++)
+			{
+				if (entry->signatures[position] == signature) return position;
+			}
+			return -1;
+		}
+
+		return entry->signatureBuckets.Find(signature, [&](vint position)
+		{
+			return position > afterPosition && entry->signatures[position] == signature;
+		});
+	}
+
+	void SymbolGroup::Add(const WString& name, const Ptr<Symbol>& symbol, Ptr<ForwardFunctionDeclaration> functionDecl)
+	{
+		vuint hash = HashString(name);
+		vint index = Find(hash, name);
+		if (index == -1)
+		{
+			auto entry = MakePtr<Entry>();
+			entry->hash = hash;
+			entry->name = name;
+			index = entries.Add(entry);
+
+			buckets.AddLast(entries.Count(), 8, [&](vint i)
+			{
+				return entries[i]->hash;
+			});
+		}
+
+		auto entry = entries[index].Obj();
+		if (!entry->listed)
+		{
+			// sortedEntries is sorted in SortEntries
+			entry->listed = true;
+			sortedEntries.Add(index);
+			sortedEntriesDirty = true;
+		}
+		entry->symbols.Add(symbol);
+
+		// a new function symbol doesn't have any declaration yet, the declaration creating it is offered instead
+		vuint signature = 0;
+		if (symbol->kind == SymbolKind::FunctionSymbol)
+		{
+			if (!functionDecl)
+			{
+				functionDecl = symbol->GetAnyForwardDecl<ForwardFunctionDeclaration>();
+			}
+			if (functionDecl)
+			{
+				signature = GetFunctionSignatureInSameScope(functionDecl);
+			}
+		}
+		entry->signatures.Add(signature);
+		AddSignature(entry, entry->symbols.Count() - 1);
+	}
+
+	void SymbolGroup::Remove(const WString& name, Symbol* symbol)
+	{
+		vint index = Find(HashString(name), name);
+		if (index == -1) return;
+
+		auto& symbols = entries[index]->symbols;
+		for (vint i = 0; i < symbols.Count(); i++)
+		{
+			if (symbols[i].Obj() == symbol)
+			{
+				symbols.RemoveAt(i);
+				entries[index]->signatures.RemoveAt(i);
+				RebuildSignatures(entries[index].Obj());
+				if (symbols.Count() == 0)
+				{
+					// the entry is dropped from sortedEntries in SortEntries
+					sortedEntriesDirty = true;
+				}
+				return;
+			}
+		}
+	}
+
+/***********************************************************************
+GenericCache
+***********************************************************************/
+
+	vuint GenericCache::Hash(ITsys* const* key, vint count)
+	{
+		vuint hash = (vuint)count;
+		for (vint i = 0; i < count; i++)
+		{
+			hash = HashCombine(hash, (vuint)key[i]);
+		}
+		return hash;
+	}
+
+	vint GenericCache::Find(vuint hash, ITsys* const* key, vint count)const
+	{
+		return buckets.Find(hash, [&](vint i)
+		{
+			auto& entry = entries[i];
+			return entry.hash == hash && entry.keyCount == count && memcmp(&keys[entry.keyBegin], key, sizeof(ITsys*) * count) == 0;
+		});
+	}
+
+	vint GenericCache::Count()const
+	{
+		return entries.Count();
+	}
+
+	vint GenericCache::GetHits()const
+	{
+		return hits;
+	}
+
+	vint GenericCache::GetMisses()const
+	{
+		return misses;
+	}
+
+	Evaluation& GenericCache::GetOrAdd(ITsys* const* key, vint count)
+	{
+		vuint hash = Hash(key, count);
+		vint index = Find(hash, key, count);
+		if (index != -1)
+		{
+			hits++;
+			CountProfilerEvent(ProfilerCounter::GenericCacheHit);
+			return *entries[index].evaluation.Obj();
+		}
+
+		misses++;
+		CountProfilerEvent(ProfilerCounter::GenericCacheMiss);
+
+		Entry entry;
+		entry.hash = hash;
+		entry.keyBegin = keys.Count();
+		entry.keyCount = count;
+		entry.evaluation = MakePtr<Evaluation>();
+		for (vint i = 0; i < count; i++)
+		{
+			keys.Add(key[i]);
+		}
+		index = entries.Add(entry);
+
+		buckets.AddLast(entries.Count(), 8, [&](vint i)
+		{
+			return entries[i].hash;
+		});
+		return *entries[index].evaluation.Obj();
+	}
+
 /***********************************************************************
 SC_Data
 ***********************************************************************/
@@ -450,8 +772,10 @@ const symbol_component::SymbolGroup& Symbol::GetChildren_NFb()
 	switch (category)
 	{
 	case symbol_component::SymbolCategory::Normal:
+		categoryData.normal.children.SortEntries();
 		return categoryData.normal.children;
 	case symbol_component::SymbolCategory::FunctionBody:
+		categoryData.functionBody.children.SortEntries();
 		return categoryData.functionBody.children;
 	default:
 		throw UnexpectedSymbolCategoryException();
@@ -535,21 +859,18 @@ void Symbol::SetClassMemberCacheForTemplateSpecScope_N(Ptr<symbol_component::Cla
 
 const List<Ptr<Symbol>>* Symbol::TryGetChildren_NFb(const WString& name)
 {
-	const auto& children = GetChildren_NFb();
-	vint index = children.Keys().IndexOf(name);
-	if (index == -1) return nullptr;
-	return &children.GetByIndex(index);
+	return GetChildren_NFb().TryGet(name);
 }
 
-void Symbol::AddChild_NFb(const WString& name, const Ptr<Symbol>& child)
+void Symbol::AddChild_NFb(const WString& name, const Ptr<Symbol>& child, Ptr<ForwardFunctionDeclaration> functionDecl)
 {
 	auto& children = const_cast<symbol_component::SymbolGroup&>(GetChildren_NFb());
-	children.Add(name, child);
+	children.Add(name, child, functionDecl);
 }
 
-void Symbol::AddChildAndSetParent_NFb(const WString& name, const Ptr<Symbol>& child)
+void Symbol::AddChildAndSetParent_NFb(const WString& name, const Ptr<Symbol>& child, Ptr<ForwardFunctionDeclaration> functionDecl)
 {
-	AddChild_NFb(name, child);
+	AddChild_NFb(name, child, functionDecl);
 	child->SetParent(this);
 }
 
@@ -571,7 +892,7 @@ Symbol* Symbol::CreateFunctionSymbol_NFb(Ptr<ForwardFunctionDeclaration> _decl)
 	{
 		symbol->name = DecorateNameForSpecializationSpec(symbol->name, _decl->specializationSpec);
 	}
-	AddChildAndSetParent_NFb(symbol->name, symbol);
+	AddChildAndSetParent_NFb(symbol->name, symbol, _decl);
 	return symbol.Obj();
 }
 
@@ -1028,19 +1349,9 @@ void EnsureFunctionBodyParsed(FunctionDeclaration* funcDecl)
 		}
 
 		funcDecl->statement = ParseStat(delayParse->pa, delayParse->begin);
-		if (delayParse->begin)
-		{
-			if (delayParse->end.reading != delayParse->begin->token.reading)
-			{
-				throw StopParsingException(delayParse->begin);
-			}
-		}
-		else
+		if (delayParse->begin != delayParse->end)
 		{
-			if (delayParse->end.reading != nullptr)
-			{
-				throw StopParsingException(delayParse->begin);
-			}
+			throw StopParsingException(delayParse->begin);
 		}
 	}
 }
@@ -1061,8 +1372,16 @@ void PredefineType(Ptr<Program> program, const ParsingArguments& pa, const wchar
 	}
 }
 
-bool ParseTypeOrExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor, Ptr<Type>& type, Ptr<Expr>& expr)
+bool ParseTypeOrExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor, Ptr<Type>& type, Ptr<Expr>& expr)
 {
+	LongTypeLookahead lookahead;
+	if (!IsPotentialLongType(pa, cursor, &lookahead))
+	{
+		// there is no type to roll back to
+		expr = ParseExpr(pa, pea, cursor);
+		return false;
+	}
+
 	auto oldCursor = cursor;
 	try
 	{
@@ -1073,11 +1392,11 @@ bool ParseTypeOrExpr(const ParsingArguments& pa, const ParsingExprArguments& pea
 	{
 	}
 	cursor = oldCursor;
-	type = ParseType(pa, cursor);
+	type = ParseType(pa, cursor, &lookahead);
 	return true;
 }
 
-Ptr<Program> ParseProgram(ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Program> ParseProgram(ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	auto program = MakePtr<Program>();
 	pa.program = program;
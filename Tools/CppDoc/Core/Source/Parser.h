@@ -146,7 +146,41 @@ namespace symbol_component
 		Function,
 	};
 
-	using SymbolGroup = Group<WString, Ptr<Symbol>>;
+	class SymbolGroup
+	{
+	protected:
+		struct Entry
+		{
+			vuint									hash = 0;
+			WString									name;
+			List<Ptr<Symbol>>						symbols;
+			List<vuint>								signatures;				// signature of each function symbol in symbols, 0 for other symbols
+			HashBuckets								signatureBuckets;		// positions in symbols by signatures, only built for large overload sets
+			vint									functionCount = 0;
+			vint									firstNonOverloadable = -1;	// position of the first symbol that a function cannot overload
+			bool									listed = false;				// the entry is in sortedEntries
+		};
+
+		List<Ptr<Entry>>							entries;			// in inserting order, an entry is kept even after all symbols are removed
+		HashBuckets									buckets;			// indices to entries by names
+		List<vint>									sortedEntries;		// indices to non-empty entries, ordered by name for the first sortedCount items, new entries are appended
+		vint										sortedCount = 0;
+		bool										sortedEntriesDirty = false;
+
+		vint										Find(vuint hash, const WString& name)const;
+		static void									AddSignature(Entry* entry, vint position);
+		static void									RebuildSignatures(Entry* entry);
+
+	public:
+		void										SortEntries();		// Count and GetByIndex require entries to be sorted after adding or removing symbols
+		vint										Count()const;
+		const List<Ptr<Symbol>>&					GetByIndex(vint index)const;
+		const List<Ptr<Symbol>>*					TryGet(const WString& name)const;
+		vint										GetFirstNonOverloadable(const WString& name)const;
+		vint										FindFunction(const WString& name, vuint signature, vint afterPosition)const;
+		void										Add(const WString& name, const Ptr<Symbol>& symbol, Ptr<ForwardFunctionDeclaration> functionDecl = nullptr);
+		void										Remove(const WString& name, Symbol* symbol);
+	};
 
 	struct SC_Normal
 	{
@@ -189,32 +223,36 @@ namespace symbol_component
 		void										Free(SymbolCategory category);
 	};
 
-	struct SG_Cache
+	// evaluations of a template symbol for each instantiation, keyed by the parent declaration type followed by template arguments
+	class GenericCache
 	{
-		Ptr<Array<ITsys*>>							parentDeclTypeAndParams;
-		Ptr<Evaluation>								cachedEvaluation;
-
-		static vint Compare(const SG_Cache& a, const SG_Cache& b)
+	protected:
+		struct Entry
 		{
-			return CompareEnumerable(*a.parentDeclTypeAndParams.Obj(), *b.parentDeclTypeAndParams.Obj());
-		}
-#define OPERATOR_COMPARE(OP)\
-		bool operator OP(const SG_Cache& cache)const\
-		{\
-			return SG_Cache::Compare(*this, cache) OP 0;\
-		}\
-
-		OPERATOR_COMPARE(> )
-		OPERATOR_COMPARE(>= )
-		OPERATOR_COMPARE(< )
-		OPERATOR_COMPARE(<= )
-		OPERATOR_COMPARE(== )
-		OPERATOR_COMPARE(!= )
-#undef OPERATOR_COMPARE
+			vuint									hash = 0;
+			vint									keyBegin = 0;		// position in keys
+			vint									keyCount = 0;
+			Ptr<Evaluation>							evaluation;
+		};
+
+		List<Entry>									entries;
+		List<ITsys*>								keys;				// keys of all entries are stored together
+		HashBuckets									buckets;			// indices to entries by keys
+		vint										hits = 0;
+		vint										misses = 0;
+
+		static vuint								Hash(ITsys* const* key, vint count);
+		vint										Find(vuint hash, ITsys* const* key, vint count)const;
+
+	public:
+		vint										Count()const;
+		vint										GetHits()const;
+		vint										GetMisses()const;
+		Evaluation&									GetOrAdd(ITsys* const* key, vint count);
 	};
 }
 
-class Symbol : public Object
+class Symbol : public CppObject
 {
 private:
 	symbol_component::SymbolCategory				category;
@@ -232,7 +270,7 @@ public:
 	WString											name;
 	WString											uniqueId;
 	List<Symbol*>									usingNss;
-	SortedList<symbol_component::SG_Cache>			genericCaches;
+	symbol_component::GenericCache					genericCache;
 
 public:
 	Symbol(symbol_component::SymbolCategory _category, Symbol* _parent = nullptr);
@@ -247,7 +285,7 @@ public:
 	const List<Ptr<Symbol>>&						GetForwardSymbols_F();			//							Function
 	Ptr<Declaration>								GetImplDecl_NFb();				//	Normal	FunctionBody
 	symbol_component::Evaluation&					GetEvaluationForUpdating_NFb();	//	Normal	FunctionBody
-	const symbol_component::SymbolGroup&			GetChildren_NFb();				//	Normal	FunctionBody
+	const symbol_component::SymbolGroup&			GetChildren_NFb();				//	Normal	FunctionBody	(sorts children changed since the last call, not thread-safe before Compile finishes)
 	const List<Ptr<Declaration>>&					GetForwardDecls_N();			//	Normal
 	const Ptr<Stat>&								GetStat_N();					//	Normal
 	Symbol*											GetFunctionSymbol_Fb();			//			FunctionBody
@@ -256,8 +294,8 @@ public:
 
 	void											SetClassMemberCacheForTemplateSpecScope_N(Ptr<symbol_component::ClassMemberCache> classMemberCache);
 	const List<Ptr<Symbol>>*						TryGetChildren_NFb(const WString& name);
-	void											AddChild_NFb(const WString& name, const Ptr<Symbol>& child);
-	void											AddChildAndSetParent_NFb(const WString& name, const Ptr<Symbol>& child);
+	void											AddChild_NFb(const WString& name, const Ptr<Symbol>& child, Ptr<ForwardFunctionDeclaration> functionDecl = nullptr);
+	void											AddChildAndSetParent_NFb(const WString& name, const Ptr<Symbol>& child, Ptr<ForwardFunctionDeclaration> functionDecl = nullptr);
 	void											RemoveChildAndResetParent_NFb(const WString& name, Symbol* child);
 
 	template<typename T>
@@ -416,17 +454,18 @@ struct ParsingArguments
 class DelayParse : public Object
 {
 public:
+	// the function body is a range in the shared token buffer, holding the buffer keeps all cursors valid
 	ParsingArguments								pa;
-	Ptr<CppTokenReader>								reader;
-	Ptr<CppTokenCursor>								begin;
-	RegexToken										end;
+	Ptr<CppTokenBuffer>								buffer;
+	CppTokenCursor*									begin = nullptr;
+	CppTokenCursor*									end = nullptr;
 };
 
 struct StopParsingException
 {
-	Ptr<CppTokenCursor>								position;
+	CppTokenCursor*									position;
 
-	StopParsingException(Ptr<CppTokenCursor> _position) :position(_position) {}
+	StopParsingException(CppTokenCursor* _position) :position(_position) {}
 };
 
 /***********************************************************************
@@ -471,15 +510,15 @@ struct ResolveSymbolResult
 	void											Merge(const ResolveSymbolResult& rar);
 };
 extern ResolveSymbolResult							ResolveSymbol(const ParsingArguments& pa, CppName& name, SearchPolicy policy, ResolveSymbolResult input = {});
-extern ResolveSymbolResult							ResolveChildSymbol(const ParsingArguments& pa, Ptr<Type> classType, CppName& name, ResolveSymbolResult input = {});
+extern ResolveSymbolResult							ResolveChildSymbol(const ParsingArguments& pa, Type* classType, CppName& name, ResolveSymbolResult input = {});
 
 // Parser_Misc.cpp
-extern bool											SkipSpecifiers(Ptr<CppTokenCursor>& cursor);
-extern bool											ParseCppName(CppName& name, Ptr<CppTokenCursor>& cursor, bool forceSpecialMethod = false);
+extern bool											SkipSpecifiers(CppTokenCursor*& cursor);
+extern bool											ParseCppName(CppName& name, CppTokenCursor*& cursor, bool forceSpecialMethod = false);
 extern Ptr<Type>									GetTypeWithoutMemberAndCC(Ptr<Type> type);
 extern Ptr<Type>									ReplaceTypeInMemberAndCC(Ptr<Type>& type, Ptr<Type> typeToReplace);
 extern Ptr<Type>									AdjustReturnTypeWithMemberAndCC(Ptr<FunctionType> functionType);
-extern bool											ParseCallingConvention(TsysCallingConvention& callingConvention, Ptr<CppTokenCursor>& cursor);
+extern bool											ParseCallingConvention(TsysCallingConvention& callingConvention, CppTokenCursor*& cursor);
 
 // Parser_Type.cpp
 enum class ShortTypeTypenameKind
@@ -488,8 +527,15 @@ enum class ShortTypeTypenameKind
 	Yes,
 	Implicit,
 };
-extern Ptr<Type>									ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, Ptr<CppTokenCursor>& cursor);
-extern Ptr<Type>									ParseLongType(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor);
+struct LongTypeLookahead
+{
+	CppTokenCursor*									idCursor = nullptr;		// the first token if it is an identifier
+	Ptr<Resolving>									idTypes;				// types resolved from the identifier at idCursor
+};
+extern Ptr<Type>									ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, CppTokenCursor*& cursor);
+extern Ptr<Type>									ParseLongType(const ParsingArguments& pa, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead = nullptr);
+extern Ptr<Type>									TryParseLongType(const ParsingArguments& pa, CppTokenCursor*& cursor);
+extern bool											IsPotentialLongType(const ParsingArguments& pa, CppTokenCursor* cursor, LongTypeLookahead* lookahead = nullptr);
 
 #define PARSING_DECLARATOR_ARGUMENTS(PREFIX, DELIMITER)												\
 	ClassDeclaration*								PREFIX##containingClass			DELIMITER		\
@@ -540,25 +586,26 @@ PDA_HEADER(Decls)			(bool allowBitField, bool allowComma)	{	return {	nullptr,	nu
 PDA_HEADER(Typedefs)		()										{	return {	nullptr,	nullptr,	false,			DeclaratorRestriction::Many,		InitializerRestriction::Zero,		false,			false,			false,		false,	false	}; } // Declarations after typedef keyword
 #undef PDA_HEADER
 
-extern void											ParseMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators);
-extern void											ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<Type> type, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators);
-extern void											ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators);
-extern Ptr<Declarator>								ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<CppTokenCursor>& cursor);
-extern Ptr<Type>									ParseType(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor);
+extern void											ParseMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators);
+extern void											ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<Type> type, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators);
+extern void											ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators, const LongTypeLookahead* lookahead = nullptr);
+extern Ptr<Declarator>								ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead = nullptr);
+extern Ptr<Type>									ParseType(const ParsingArguments& pa, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead = nullptr);
+extern Ptr<Type>									TryParseType(const ParsingArguments& pa, CppTokenCursor*& cursor);
 
 // Parser_Template.cpp
-extern void											ParseTemplateSpec(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<Symbol>& specSymbol, Ptr<TemplateSpec>& spec);
-extern void											ValidateForRootTemplateSpec(Ptr<TemplateSpec>& spec, Ptr<CppTokenCursor>& cursor);
-extern void											ParseSpecializationSpec(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<SpecializationSpec>& spec);
-extern void											ParseGenericArgumentsSkippedLT(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, VariadicList<GenericArgument>& arguments, CppTokens ending);
+extern void											ParseTemplateSpec(const ParsingArguments& pa, CppTokenCursor*& cursor, Ptr<Symbol>& specSymbol, Ptr<TemplateSpec>& spec);
+extern void											ValidateForRootTemplateSpec(Ptr<TemplateSpec>& spec, CppTokenCursor*& cursor);
+extern void											ParseSpecializationSpec(const ParsingArguments& pa, CppTokenCursor*& cursor, Ptr<SpecializationSpec>& spec);
+extern void											ParseGenericArgumentsSkippedLT(const ParsingArguments& pa, CppTokenCursor*& cursor, VariadicList<GenericArgument>& arguments, CppTokens ending);
 
 // Parser_Declaration.cpp
-extern void											ParseDeclaration(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output);
+extern void											ParseDeclaration(const ParsingArguments& pa, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output);
 extern void											BuildVariables(List<Ptr<Declarator>>& declarators, List<Ptr<VariableDeclaration>>& varDecls);
-extern void											BuildSymbols(const ParsingArguments& pa, List<Ptr<VariableDeclaration>>& varDecls, Ptr<CppTokenCursor>& cursor);
-extern void											BuildSymbols(const ParsingArguments& pa, VariadicList<Ptr<VariableDeclaration>>& varDecls, Ptr<CppTokenCursor>& cursor);
-extern void											BuildVariablesAndSymbols(const ParsingArguments& pa, List<Ptr<Declarator>>& declarators, List<Ptr<VariableDeclaration>>& varDecls, Ptr<CppTokenCursor>& cursor);
-extern Ptr<VariableDeclaration>						BuildVariableAndSymbol(const ParsingArguments& pa, Ptr<Declarator> declarator, Ptr<CppTokenCursor>& cursor);
+extern void											BuildSymbols(const ParsingArguments& pa, List<Ptr<VariableDeclaration>>& varDecls, CppTokenCursor*& cursor);
+extern void											BuildSymbols(const ParsingArguments& pa, VariadicList<Ptr<VariableDeclaration>>& varDecls, CppTokenCursor*& cursor);
+extern void											BuildVariablesAndSymbols(const ParsingArguments& pa, List<Ptr<Declarator>>& declarators, List<Ptr<VariableDeclaration>>& varDecls, CppTokenCursor*& cursor);
+extern Ptr<VariableDeclaration>						BuildVariableAndSymbol(const ParsingArguments& pa, Ptr<Declarator> declarator, CppTokenCursor*& cursor);
 
 // Parser_Expr.cpp
 struct ParsingExprArguments
@@ -574,15 +621,15 @@ inline ParsingExprArguments							pea_Argument()
 inline ParsingExprArguments							pea_GenericArgument()
 	{	return { false, false }; }
 
-extern Ptr<Expr>									ParseExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor);
+extern Ptr<Expr>									ParseExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor);
 
 // Parser_Stat.cpp
-extern Ptr<Stat>									ParseStat(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor);
+extern Ptr<Stat>									ParseStat(const ParsingArguments& pa, CppTokenCursor*& cursor);
 
 // Parser.cpp
 extern void											EnsureFunctionBodyParsed(FunctionDeclaration* funcDecl);
-extern bool											ParseTypeOrExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor, Ptr<Type>& type, Ptr<Expr>& expr);
-extern Ptr<Program>									ParseProgram(ParsingArguments& pa, Ptr<CppTokenCursor>& cursor);
+extern bool											ParseTypeOrExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor, Ptr<Type>& type, Ptr<Expr>& expr);
+extern Ptr<Program>									ParseProgram(ParsingArguments& pa, CppTokenCursor*& cursor);
 extern Symbol*										FindParentClassSymbol(Symbol* symbol, bool includeThisSymbol);
 
 /***********************************************************************
@@ -590,7 +637,7 @@ Helpers
 ***********************************************************************/
 
 // Test if the next token's content matches the expected value
-__forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, const wchar_t* content, bool autoSkip = true)
+__forceinline bool TestToken(CppTokenCursor*& cursor, const wchar_t* content, bool autoSkip = true)
 {
 	vint length = (vint)wcslen(content);
 	if (cursor && cursor->token.length == length && wcsncmp(cursor->token.reading, content, length) == 0)
@@ -602,7 +649,7 @@ __forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, const wchar_t* content
 }
 
 // Test if the next token's type matches the expected value
-__forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, bool autoSkip = true)
+__forceinline bool TestToken(CppTokenCursor*& cursor, CppTokens token1, bool autoSkip = true)
 {
 	if (cursor && (CppTokens)cursor->token.token == token1)
 	{
@@ -624,7 +671,7 @@ __forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, bool
 	}\
 
 // Test if next two tokens' types match expected value, and there should not be spaces between tokens
-__forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, CppTokens token2, bool autoSkip = true)
+__forceinline bool TestToken(CppTokenCursor*& cursor, CppTokens token1, CppTokens token2, bool autoSkip = true)
 {
 	if (auto current = cursor)
 	{
@@ -638,7 +685,7 @@ __forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, CppT
 }
 
 // Test if next three tokens' types match expected value, and there should not be spaces between tokens
-__forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, CppTokens token2, CppTokens token3, bool autoSkip = true)
+__forceinline bool TestToken(CppTokenCursor*& cursor, CppTokens token1, CppTokens token2, CppTokens token3, bool autoSkip = true)
 {
 	if (auto current = cursor)
 	{
@@ -653,7 +700,7 @@ __forceinline bool TestToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, CppT
 }
 
 // Throw exception if failed to test
-__forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, const wchar_t* content)
+__forceinline void RequireToken(CppTokenCursor*& cursor, const wchar_t* content)
 {
 	if (!TestToken(cursor, content))
 	{
@@ -662,7 +709,7 @@ __forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, const wchar_t* cont
 }
 
 // Throw exception if failed to test
-__forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, CppTokens token1)
+__forceinline void RequireToken(CppTokenCursor*& cursor, CppTokens token1)
 {
 	if (!TestToken(cursor, token1))
 	{
@@ -671,7 +718,7 @@ __forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, CppTokens token1)
 }
 
 // Throw exception if failed to test
-__forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, CppTokens token2)
+__forceinline void RequireToken(CppTokenCursor*& cursor, CppTokens token1, CppTokens token2)
 {
 	if (!TestToken(cursor, token1, token2))
 	{
@@ -680,7 +727,7 @@ __forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, C
 }
 
 // Throw exception if failed to test
-__forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, CppTokens token2, CppTokens token3)
+__forceinline void RequireToken(CppTokenCursor*& cursor, CppTokens token1, CppTokens token2, CppTokens token3)
 {
 	if (!TestToken(cursor, token1, token2, token3))
 	{
@@ -689,7 +736,7 @@ __forceinline void RequireToken(Ptr<CppTokenCursor>& cursor, CppTokens token1, C
 }
 
 // Skip one token
-__forceinline void SkipToken(Ptr<CppTokenCursor>& cursor)
+__forceinline void SkipToken(CppTokenCursor*& cursor)
 {
 	if (cursor)
 	{
@@ -6,7 +6,7 @@
 ParseDeclaration_<NAMESPACE>
 ***********************************************************************/
 
-void ParseDeclaration_Namespace(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseDeclaration_Namespace(const ParsingArguments& pa, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	RequireToken(cursor, CppTokens::DECL_NAMESPACE);
 	if (TestToken(cursor, CppTokens::LBRACE))
@@ -78,7 +78,7 @@ void ParseDeclaration_Namespace(const ParsingArguments& pa, Ptr<CppTokenCursor>&
 ParseDeclaration_<ENUM>
 ***********************************************************************/
 
-Ptr<EnumDeclaration> ParseDeclaration_Enum_NotConsumeSemicolon(const ParsingArguments& pa, bool forTypeDef, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+Ptr<EnumDeclaration> ParseDeclaration_Enum_NotConsumeSemicolon(const ParsingArguments& pa, bool forTypeDef, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	RequireToken(cursor, CppTokens::DECL_ENUM);
 	// enum [CLASS] NAME [: TYPE] ...
@@ -184,7 +184,7 @@ Ptr<EnumDeclaration> ParseDeclaration_Enum_NotConsumeSemicolon(const ParsingArgu
 ParseDeclaration_<CLASS / STRUCT / UNION>
 ***********************************************************************/
 
-Ptr<ClassDeclaration> ParseDeclaration_Class_NotConsumeSemicolon(const ParsingArguments& pa, Ptr<Symbol> specSymbol, Ptr<TemplateSpec> spec, bool forTypeDef, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+Ptr<ClassDeclaration> ParseDeclaration_Class_NotConsumeSemicolon(const ParsingArguments& pa, Ptr<Symbol> specSymbol, Ptr<TemplateSpec> spec, bool forTypeDef, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	// [union | class | struct] NAME ...
 	auto classType = CppClassType::Union;
@@ -403,6 +403,7 @@ Ptr<ClassDeclaration> ParseDeclaration_Class_NotConsumeSemicolon(const ParsingAr
 				GenerateMembers(declPa, classContextSymbol);
 			}
 		}
+		decl->completed = true;
 		return decl;
 	}
 }
@@ -411,7 +412,7 @@ Ptr<ClassDeclaration> ParseDeclaration_Class_NotConsumeSemicolon(const ParsingAr
 ParseDeclaration_<USING>
 ***********************************************************************/
 
-void ParseDeclaration_Using(const ParsingArguments& pa, Ptr<Symbol> specSymbol, Ptr<TemplateSpec> spec, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseDeclaration_Using(const ParsingArguments& pa, Ptr<Symbol> specSymbol, Ptr<TemplateSpec> spec, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	RequireToken(cursor, CppTokens::DECL_USING);
 	if (TestToken(cursor, CppTokens::DECL_NAMESPACE))
@@ -575,7 +576,7 @@ void ParseDeclaration_Using(const ParsingArguments& pa, Ptr<Symbol> specSymbol,
 ParseDeclaration_<TYPEDEF>
 ***********************************************************************/
 
-bool IsCStyleTypeReference(Ptr<CppTokenCursor>& cursor)
+bool IsCStyleTypeReference(CppTokenCursor*& cursor)
 {
 	bool cStyleTypeReference = false;
 	if (TestToken(cursor, CppTokens::DECL_ENUM, false) || TestToken(cursor, CppTokens::DECL_CLASS, false) || TestToken(cursor, CppTokens::DECL_STRUCT, false) || TestToken(cursor, CppTokens::DECL_UNION, false))
@@ -595,7 +596,7 @@ bool IsCStyleTypeReference(Ptr<CppTokenCursor>& cursor)
 	return cStyleTypeReference;
 }
 
-void ParseDeclaration_Typedef(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseDeclaration_Typedef(const ParsingArguments& pa, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	RequireToken(cursor, CppTokens::DECL_TYPEDEF);
 	List<Ptr<Declarator>> declarators;
@@ -697,7 +698,7 @@ ParseDeclaration_FuncVar
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void EnsureNoTemplateSpec(List<Ptr<TemplateSpec>>& specs, Ptr<CppTokenCursor>& cursor)
+void EnsureNoTemplateSpec(List<Ptr<TemplateSpec>>& specs, CppTokenCursor*& cursor)
 {
 	if (specs.Count() > 0)
 	{
@@ -705,7 +706,7 @@ void EnsureNoTemplateSpec(List<Ptr<TemplateSpec>>& specs, Ptr<CppTokenCursor>& c
 	}
 }
 
-Ptr<TemplateSpec> EnsureNoMultipleTemplateSpec(List<Ptr<TemplateSpec>>& specs, Ptr<CppTokenCursor>& cursor)
+Ptr<TemplateSpec> EnsureNoMultipleTemplateSpec(List<Ptr<TemplateSpec>>& specs, CppTokenCursor*& cursor)
 {
 	if (specs.Count() > 1)
 	{
@@ -723,35 +724,34 @@ Ptr<TemplateSpec> EnsureNoMultipleTemplateSpec(List<Ptr<TemplateSpec>>& specs, P
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-Symbol* SearchForFunctionWithSameSignature(Symbol* context, Ptr<ForwardFunctionDeclaration> decl, Ptr<CppTokenCursor>& cursor)
+Symbol* SearchForFunctionWithSameSignature(Symbol* context, Ptr<ForwardFunctionDeclaration> decl, CppTokenCursor*& cursor)
 {
 	if (!decl->needResolveTypeFromStatement && !decl->specializationSpec)
 	{
-		if (auto pSymbols = context->TryGetChildren_NFb(decl->name.name))
+		auto& children = context->GetChildren_NFb();
+		if (auto pSymbols = children.TryGet(decl->name.name))
 		{
-			for (vint i = 0; i < pSymbols->Count(); i++)
+			// only functions of the same signature could be compatible
+			// function can only override enum/class/struct/union, symbols before the first other symbol are searched
+			vint firstNonOverloadable = children.GetFirstNonOverloadable(decl->name.name);
+			vint end = firstNonOverloadable == -1 ? pSymbols->Count() : firstNonOverloadable;
+			vuint signature = GetFunctionSignatureInSameScope(decl);
+
+			vint position = -1;
+			while ((position = children.FindFunction(decl->name.name, signature, position)) != -1 && position < end)
 			{
-				auto symbol = pSymbols->Get(i).Obj();
-				if (symbol->kind == symbol_component::SymbolKind::FunctionSymbol)
+				auto symbol = pSymbols->Get(position).Obj();
+				auto declToCompare = symbol->GetAnyForwardDecl<ForwardFunctionDeclaration>();
+				if (IsCompatibleFunctionDeclInSameScope(decl, declToCompare))
 				{
-					auto declToCompare = symbol->GetAnyForwardDecl<ForwardFunctionDeclaration>();
-					if (IsCompatibleFunctionDeclInSameScope(decl, declToCompare))
-					{
-						return symbol;
-					}
-				}
-				else
-				{
-					switch (symbol->kind)
-					{
-					case CSTYLE_TYPE_SYMBOL_KIND:
-						// function can only override enum/class/struct/union
-						break;
-					default:
-						throw StopParsingException(cursor);
-					}
+					return symbol;
 				}
 			}
+
+			if (firstNonOverloadable != -1)
+			{
+				throw StopParsingException(cursor);
+			}
 		}
 	}
 	return context->CreateFunctionSymbol_NFb(decl);
@@ -765,7 +765,7 @@ void ParseDeclaration_Function(
 	Ptr<FunctionType> funcType,
 	FUNCVAR_DECORATORS_FOR_FUNCTION(FUNCVAR_PARAMETER)
 	CppMethodType methodType,
-	Ptr<CppTokenCursor>& cursor,
+	CppTokenCursor*& cursor,
 	List<Ptr<Declaration>>& output
 )
 {
@@ -894,7 +894,8 @@ void ParseDeclaration_Function(
 			// delay parse the statement
 			decl->delayParse = MakePtr<DelayParse>();
 			decl->delayParse->pa = newPa;
-			cursor->Clone(decl->delayParse->reader, decl->delayParse->begin);
+			decl->delayParse->buffer = cursor->GetBuffer();
+			decl->delayParse->begin = cursor;
 
 			vint counter = 0;
 			while (true)
@@ -908,14 +909,7 @@ void ParseDeclaration_Function(
 					counter--;
 					if (counter == 0)
 					{
-						if (cursor)
-						{
-							decl->delayParse->end = cursor->token;
-						}
-						else
-						{
-							memset(&decl->delayParse->end, 0, sizeof(RegexToken));
-						}
+						decl->delayParse->end = cursor;
 						break;
 					}
 				}
@@ -962,7 +956,7 @@ void ParseDeclaration_Variable(
 	Ptr<TemplateSpec> spec,
 	Ptr<Declarator> declarator,
 	FUNCVAR_DECORATORS_FOR_VARIABLE(FUNCVAR_PARAMETER)
-	Ptr<CppTokenCursor>& cursor,
+	CppTokenCursor*& cursor,
 	List<Ptr<Declaration>>& output
 )
 {
@@ -1062,7 +1056,7 @@ void ParseDeclaration_Variable(
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void ParseDeclaration_FuncVar(const ParsingArguments& pa, Ptr<Symbol> specSymbol, List<Ptr<TemplateSpec>>& specs, bool decoratorFriend, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseDeclaration_FuncVar(const ParsingArguments& pa, Ptr<Symbol> specSymbol, List<Ptr<TemplateSpec>>& specs, bool decoratorFriend, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	// parse declarators for functions and variables
 
@@ -1210,7 +1204,7 @@ void ParseDeclaration_FuncVar(const ParsingArguments& pa, Ptr<Symbol> specSymbol
 ParseDeclaration
 ***********************************************************************/
 
-void ParseVariablesFollowedByDecl_NotConsumeSemicolon(const ParsingArguments& pa, Ptr<Declaration> decl, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseVariablesFollowedByDecl_NotConsumeSemicolon(const ParsingArguments& pa, Ptr<Declaration> decl, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	auto type = MakePtr<IdType>();
 	type->name = decl->name;
@@ -1234,7 +1228,7 @@ void ParseVariablesFollowedByDecl_NotConsumeSemicolon(const ParsingArguments& pa
 	}
 }
 
-void ParseDeclaration_StaticAssert(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseDeclaration_StaticAssert(const ParsingArguments& pa, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	RequireToken(cursor, CppTokens::STATIC_ASSERT);
 	RequireToken(cursor, CppTokens::LPARENTHESIS);
@@ -1258,7 +1252,7 @@ void ParseDeclaration_StaticAssert(const ParsingArguments& pa, Ptr<CppTokenCurso
 	RequireToken(cursor, CppTokens::SEMICOLON);
 }
 
-void ParseDeclaration(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, List<Ptr<Declaration>>& output)
+void ParseDeclaration(const ParsingArguments& pa, CppTokenCursor*& cursor, List<Ptr<Declaration>>& output)
 {
 	while (SkipSpecifiers(cursor));
 	if (TestToken(cursor, CppTokens::SEMICOLON))
@@ -1347,11 +1341,6 @@ void ParseDeclaration(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, L
 				ParseDeclaration(pa, cursor, output);
 			}
 
-			// prevent from stack overflowing in CppTokenCursor's destructor
-			while (oldCursor != cursor)
-			{
-				oldCursor = oldCursor->Next();
-			}
 			return;
 		}
 		else
@@ -1428,7 +1417,7 @@ void BuildVariables(List<Ptr<Declarator>>& declarators, List<Ptr<VariableDeclara
 BuildSymbols
 ***********************************************************************/
 
-void BuildSymbol(const ParsingArguments& pa, Ptr<VariableDeclaration> varDecl, bool isVariadic, Ptr<CppTokenCursor>& cursor)
+void BuildSymbol(const ParsingArguments& pa, Ptr<VariableDeclaration> varDecl, bool isVariadic, CppTokenCursor*& cursor)
 {
 	if (varDecl->name)
 	{
@@ -1441,7 +1430,7 @@ void BuildSymbol(const ParsingArguments& pa, Ptr<VariableDeclaration> varDecl, b
 	}
 }
 
-void BuildSymbols(const ParsingArguments& pa, List<Ptr<VariableDeclaration>>& varDecls, Ptr<CppTokenCursor>& cursor)
+void BuildSymbols(const ParsingArguments& pa, List<Ptr<VariableDeclaration>>& varDecls, CppTokenCursor*& cursor)
 {
 	for (vint i = 0; i < varDecls.Count(); i++)
 	{
@@ -1449,7 +1438,7 @@ void BuildSymbols(const ParsingArguments& pa, List<Ptr<VariableDeclaration>>& va
 	}
 }
 
-void BuildSymbols(const ParsingArguments& pa, VariadicList<Ptr<VariableDeclaration>>& varDecls, Ptr<CppTokenCursor>& cursor)
+void BuildSymbols(const ParsingArguments& pa, VariadicList<Ptr<VariableDeclaration>>& varDecls, CppTokenCursor*& cursor)
 {
 	for (vint i = 0; i < varDecls.Count(); i++)
 	{
@@ -1461,7 +1450,7 @@ void BuildSymbols(const ParsingArguments& pa, VariadicList<Ptr<VariableDeclarati
 BuildVariablesAndSymbols
 ***********************************************************************/
 
-void BuildVariablesAndSymbols(const ParsingArguments& pa, List<Ptr<Declarator>>& declarators, List<Ptr<VariableDeclaration>>& varDecls, Ptr<CppTokenCursor>& cursor)
+void BuildVariablesAndSymbols(const ParsingArguments& pa, List<Ptr<Declarator>>& declarators, List<Ptr<VariableDeclaration>>& varDecls, CppTokenCursor*& cursor)
 {
 	BuildVariables(declarators, varDecls);
 	BuildSymbols(pa, varDecls, cursor);
@@ -1471,7 +1460,7 @@ void BuildVariablesAndSymbols(const ParsingArguments& pa, List<Ptr<Declarator>>&
 BuildVariableAndSymbol
 ***********************************************************************/
 
-Ptr<VariableDeclaration> BuildVariableAndSymbol(const ParsingArguments& pa, Ptr<Declarator> declarator, Ptr<CppTokenCursor>& cursor)
+Ptr<VariableDeclaration> BuildVariableAndSymbol(const ParsingArguments& pa, Ptr<Declarator> declarator, CppTokenCursor*& cursor)
 {
 	List<Ptr<Declarator>> declarators;
 	declarators.Add(declarator);
@@ -11,14 +11,14 @@ template<typename TCreator>
 class ReplaceOutOfDeclaratorTypeVisitor : public Object, public virtual ITypeVisitor
 {
 private:
-	Ptr<CppTokenCursor>&			cursor;
+	CppTokenCursor*&				cursor;
 	Ptr<Type>						typeToReplace;
 	TCreator						typeCreator;
 
 public:
 	Ptr<Type>						createdType;
 
-	ReplaceOutOfDeclaratorTypeVisitor(Ptr<CppTokenCursor>& _cursor, Ptr<Type> _typeToReplace, TCreator&& _typeCreator)
+	ReplaceOutOfDeclaratorTypeVisitor(CppTokenCursor*& _cursor, Ptr<Type> _typeToReplace, TCreator&& _typeCreator)
 		:cursor(_cursor)
 		, typeToReplace(_typeToReplace)
 		, typeCreator(ForwardValue<TCreator>(_typeCreator))
@@ -112,7 +112,7 @@ public:
 };
 
 template<typename T>
-ReplaceOutOfDeclaratorTypeVisitor<T> MakeReplacer(Ptr<CppTokenCursor>& _cursor, Ptr<Type> _typeToReplace, T&& _typeCreator)
+ReplaceOutOfDeclaratorTypeVisitor<T> MakeReplacer(CppTokenCursor*& _cursor, Ptr<Type> _typeToReplace, T&& _typeCreator)
 {
 	return { _cursor,_typeToReplace,ForwardValue<T>(_typeCreator) };
 }
@@ -121,7 +121,7 @@ ReplaceOutOfDeclaratorTypeVisitor<T> MakeReplacer(Ptr<CppTokenCursor>& _cursor,
 EnsureMemberTypeResolved
 ***********************************************************************/
 
-ClassDeclaration* EnsureMemberTypeResolved(Ptr<MemberType> memberType, Ptr<CppTokenCursor>& cursor)
+ClassDeclaration* EnsureMemberTypeResolved(Ptr<MemberType> memberType, CppTokenCursor*& cursor)
 {
 	auto catIdChildType = memberType->classType.Cast<Category_Id_Child_Type>();
 	if (!catIdChildType)
@@ -165,7 +165,7 @@ struct ParseDeclaratorContext
 ParseDeclaratorName
 ***********************************************************************/
 
-bool ParseDeclaratorName(const ParsingArguments& pa, CppName& cppName, Ptr<Type> targetType, const ParseDeclaratorContext& pdc, Ptr<CppTokenCursor>& cursor)
+bool ParseDeclaratorName(const ParsingArguments& pa, CppName& cppName, Ptr<Type> targetType, const ParseDeclaratorContext& pdc, CppTokenCursor*& cursor)
 {
 	// forceSpecialMethod means this function is expected to accept only
 	//   constructor declarators
@@ -248,7 +248,7 @@ bool ParseDeclaratorName(const ParsingArguments& pa, CppName& cppName, Ptr<Type>
 ParseTypeBeforeDeclarator
 ***********************************************************************/
 
-Ptr<Type> ParseTypeBeforeDeclarator(const ParsingArguments& pa, Ptr<Type> baselineType, const ParseDeclaratorContext& pdc, Ptr<CppTokenCursor>& cursor)
+Ptr<Type> ParseTypeBeforeDeclarator(const ParsingArguments& pa, Ptr<Type> baselineType, const ParseDeclaratorContext& pdc, CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::ALIGNAS))
 	{
@@ -369,7 +369,7 @@ Ptr<Type> ParseTypeBeforeDeclarator(const ParsingArguments& pa, Ptr<Type> baseli
 ParseSingleDeclarator_Array
 ***********************************************************************/
 
-bool ParseSingleDeclarator_Array(const ParsingArguments& pa, Ptr<Declarator> declarator, Ptr<Type> targetType, bool forParameter, Ptr<CppTokenCursor>& cursor)
+bool ParseSingleDeclarator_Array(const ParsingArguments& pa, Ptr<Declarator> declarator, Ptr<Type> targetType, bool forParameter, CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::LBRACKET))
 	{
@@ -416,7 +416,7 @@ bool ParseSingleDeclarator_Array(const ParsingArguments& pa, Ptr<Declarator> dec
 ParseSingleDeclarator_Function
 ***********************************************************************/
 
-bool ParseSingleDeclarator_Function(const ParsingArguments& pa, Ptr<Declarator> declarator, Ptr<Type> targetType, bool forceSpecialMethod, bool allowSpecializationSpec, Ptr<CppTokenCursor>& cursor)
+bool ParseSingleDeclarator_Function(const ParsingArguments& pa, Ptr<Declarator> declarator, Ptr<Type> targetType, bool forceSpecialMethod, bool allowSpecializationSpec, CppTokenCursor*& cursor)
 {
 	// if it is not an array declarator, then there are only two possibilities
 	//   1. it is a function declarator
@@ -756,7 +756,7 @@ Ptr<symbol_component::ClassMemberCache> CreatePartialClassMemberCache(const Pars
 }
 
 template<typename TCallback>
-void InjectClassMemberCacheIfNecessary(const ParsingArguments& pa, const ParseDeclaratorContext& pdc, Ptr<Declarator> declarator, Ptr<CppTokenCursor>& cursor, TCallback&& callback)
+void InjectClassMemberCacheIfNecessary(const ParsingArguments& pa, const ParseDeclaratorContext& pdc, Ptr<Declarator> declarator, CppTokenCursor*& cursor, TCallback&& callback)
 {
 	if (pdc.scopeSymbolToReuse)
 	{
@@ -796,7 +796,7 @@ void InjectClassMemberCacheIfNecessary(const ParsingArguments& pa, const ParseDe
 	}
 }
 
-Ptr<Declarator> ParseSingleDeclarator(const ParsingArguments& pa, Ptr<Type> baselineType, const ParseDeclaratorContext& pdc, bool parsingTypeConversionOperatorOutsideOfClass, Ptr<CppTokenCursor>& cursor)
+Ptr<Declarator> ParseSingleDeclarator(const ParsingArguments& pa, Ptr<Type> baselineType, const ParseDeclaratorContext& pdc, bool parsingTypeConversionOperatorOutsideOfClass, CppTokenCursor*& cursor)
 {
 	Ptr<Declarator> declarator;
 
@@ -914,7 +914,7 @@ READY_FOR_ARRAY_OR_FUNCTION:
 ParseInitializer
 ***********************************************************************/
 
-Ptr<Initializer> ParseInitializer(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, bool allowComma, bool allowGT)
+Ptr<Initializer> ParseInitializer(const ParsingArguments& pa, CppTokenCursor*& cursor, bool allowComma, bool allowGT)
 {
 	// = EXPRESSION
 	// { { EXPRESSION , ...} }
@@ -978,7 +978,7 @@ Ptr<Initializer> ParseInitializer(const ParsingArguments& pa, Ptr<CppTokenCursor
 ParseDeclaratorWithInitializer
 ***********************************************************************/
 
-void ParseDeclaratorWithInitializer(const ParsingArguments& pa, Ptr<Type> typeResult, const ParseDeclaratorContext& pdc, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators)
+void ParseDeclaratorWithInitializer(const ParsingArguments& pa, Ptr<Type> typeResult, const ParseDeclaratorContext& pdc, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators)
 {
 	while (true)
 	{
@@ -1114,7 +1114,7 @@ void ParseDeclaratorWithInitializer(const ParsingArguments& pa, Ptr<Type> typeRe
 ParseDeclarator
 ***********************************************************************/
 
-void ParseDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, bool trySpecialMember, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators)
+void ParseDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, bool trySpecialMember, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators, const LongTypeLookahead* lookahead)
 {
 	if (trySpecialMember && pda.dr == DeclaratorRestriction::Many)
 	{
@@ -1154,7 +1154,7 @@ void ParseDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArgument
 		cursor = oldCursor;
 	}
 
-	auto typeResult = ParseLongType(pa, cursor);
+	auto typeResult = ParseLongType(pa, cursor, lookahead);
 	ParseDeclaratorWithInitializer(pa, typeResult, { pda,false }, cursor, declarators);
 }
 
@@ -1162,30 +1162,51 @@ void ParseDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArgument
 ParseDeclarator (Helpers)
 ***********************************************************************/
 
-void ParseMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators)
+void ParseMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators)
 {
-	ParseDeclarator(pa, pda, true, cursor, declarators);
+	ParseDeclarator(pa, pda, true, cursor, declarators, nullptr);
 }
 
-void ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<Type> type, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators)
+void ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<Type> type, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators)
 {
 	ParseDeclaratorWithInitializer(pa, type, { pda,false }, cursor, declarators);
 }
 
-void ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<CppTokenCursor>& cursor, List<Ptr<Declarator>>& declarators)
+void ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, CppTokenCursor*& cursor, List<Ptr<Declarator>>& declarators, const LongTypeLookahead* lookahead)
 {
-	ParseDeclarator(pa, pda, false, cursor, declarators);
+	ParseDeclarator(pa, pda, false, cursor, declarators, lookahead);
 }
 
-Ptr<Declarator> ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, Ptr<CppTokenCursor>& cursor)
+Ptr<Declarator> ParseNonMemberDeclarator(const ParsingArguments& pa, const ParsingDeclaratorArguments& pda, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead)
 {
 	List<Ptr<Declarator>> declarators;
-	ParseNonMemberDeclarator(pa, pda, cursor, declarators);
+	ParseNonMemberDeclarator(pa, pda, cursor, declarators, lookahead);
 	if (declarators.Count() != 1) throw StopParsingException(cursor);
 	return declarators[0];
 }
 
-Ptr<Type> ParseType(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Type> ParseType(const ParsingArguments& pa, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead)
 {
-	return ParseNonMemberDeclarator(pa, pda_Type(), cursor)->type;
+	return ParseNonMemberDeclarator(pa, pda_Type(), cursor, lookahead)->type;
+}
+
+// returns nullptr and keeps the cursor unchanged if there is no type at the cursor
+Ptr<Type> TryParseType(const ParsingArguments& pa, CppTokenCursor*& cursor)
+{
+	LongTypeLookahead lookahead;
+	if (!IsPotentialLongType(pa, cursor, &lookahead))
+	{
+		return nullptr;
+	}
+
+	auto oldCursor = cursor;
+	try
+	{
+		return ParseType(pa, cursor, &lookahead);
+	}
+	catch (const StopParsingException&)
+	{
+		cursor = oldCursor;
+		return nullptr;
+	}
 }
\ No newline at end of file
@@ -6,7 +6,7 @@
 FillOperatorAndSkip
 ***********************************************************************/
 
-void FillOperatorAndSkip(CppName& name, Ptr<CppTokenCursor>& cursor, vint count)
+void FillOperatorAndSkip(CppName& name, CppTokenCursor*& cursor, vint count)
 {
 	auto reading = cursor->token.reading;
 	vint length = 0;
@@ -84,7 +84,7 @@ void FillOperator(CppName& name, CppBinaryOp& op)
 ParseIdExpr
 ***********************************************************************/
 
-Ptr<IdExpr> ParseIdExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<IdExpr> ParseIdExpr(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	CppName cppName;
 	if (ParseCppName(cppName, cursor))
@@ -115,7 +115,7 @@ Ptr<IdExpr> ParseIdExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
 TryParseChildExpr
 ***********************************************************************/
 
-Ptr<ChildExpr> TryParseChildExpr(const ParsingArguments& pa, Ptr<Type> classType, bool& templateKeyword, Ptr<CppTokenCursor>& cursor)
+Ptr<ChildExpr> TryParseChildExpr(const ParsingArguments& pa, Type* classType, bool& templateKeyword, CppTokenCursor*& cursor)
 {
 	templateKeyword = TestToken(cursor, CppTokens::DECL_TEMPLATE);
 	CppName cppName;
@@ -153,7 +153,7 @@ Ptr<ChildExpr> TryParseChildExpr(const ParsingArguments& pa, Ptr<Type> classType
 ParseNameOrCtorAccessExpr
 ***********************************************************************/
 
-Ptr<GenericExpr> ParseGenericExprSkippedLT(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<Category_Id_Child_Expr> catIdChildExpr)
+Ptr<GenericExpr> ParseGenericExprSkippedLT(const ParsingArguments& pa, CppTokenCursor*& cursor, Category_Id_Child_Expr* catIdChildExpr)
 {
 	// EXPR< { TYPE/EXPR ...} >
 	auto expr = MakePtr<GenericExpr>();
@@ -162,7 +162,7 @@ Ptr<GenericExpr> ParseGenericExprSkippedLT(const ParsingArguments& pa, Ptr<CppTo
 	return expr;
 }
 
-Ptr<Category_Id_Child_Generic_Expr> TryParseGenericExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<Category_Id_Child_Expr> catIdChildExpr, bool templateKeyword, bool tryGenericForEmptyResolving)
+Ptr<Category_Id_Child_Generic_Expr> TryParseGenericExpr(const ParsingArguments& pa, CppTokenCursor*& cursor, Category_Id_Child_Expr* catIdChildExpr, bool templateKeyword, bool tryGenericForEmptyResolving)
 {
 	if (!TestToken(cursor, CppTokens::LT, false))
 	{
@@ -227,20 +227,19 @@ Ptr<Category_Id_Child_Generic_Expr> TryParseGenericExpr(const ParsingArguments&
 	}
 }
 
-Ptr<Expr> ParseNameOrCtorAccessExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParseNameOrCtorAccessExpr(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
+	auto oldCursor = cursor;
+	if (auto type = TryParseLongType(pa, cursor))
 	{
-		auto oldCursor = cursor;
 		try
 		{
-			auto type = ParseLongType(pa, cursor);
-
 			if (TestToken(cursor, CppTokens::COLON, CppTokens::COLON))
 			{
 				bool templateKeyword = false;
-				if (auto expr = TryParseChildExpr(pa, type, templateKeyword, cursor))
+				if (auto expr = TryParseChildExpr(pa, type.Obj(), templateKeyword, cursor))
 				{
-					return TryParseGenericExpr(pa, cursor, expr, templateKeyword, false);
+					return TryParseGenericExpr(pa, cursor, expr.Obj(), templateKeyword, false);
 				}
 			}
 
@@ -273,34 +272,30 @@ Ptr<Expr> ParseNameOrCtorAccessExpr(const ParsingArguments& pa, Ptr<CppTokenCurs
 				}
 				return expr;
 			}
-
-			throw StopParsingException(cursor);
 		}
 		catch (const StopParsingException&)
 		{
-			cursor = oldCursor;
-			goto GIVE_UP_CHILD_SYMBOL;
 		}
+		cursor = oldCursor;
 	}
-GIVE_UP_CHILD_SYMBOL:
 
 	if (TestToken(cursor, CppTokens::COLON, CppTokens::COLON))
 	{
 		bool templateKeyword = false;
-		if (auto expr = TryParseChildExpr(pa, MakePtr<RootType>(), templateKeyword, cursor))
+		if (auto expr = TryParseChildExpr(pa, MakePtr<RootType>().Obj(), templateKeyword, cursor))
 		{
 			if (templateKeyword)
 			{
 				throw StopParsingException(cursor);
 			}
-			return TryParseGenericExpr(pa, cursor, expr, false, false);
+			return TryParseGenericExpr(pa, cursor, expr.Obj(), false, false);
 		}
 	}
 	else
 	{
 		if (auto expr = ParseIdExpr(pa, cursor))
 		{
-			return TryParseGenericExpr(pa, cursor, expr, false, false);
+			return TryParseGenericExpr(pa, cursor, expr.Obj(), false, false);
 		}
 	}
 	throw StopParsingException(cursor);
@@ -310,7 +305,7 @@ GIVE_UP_CHILD_SYMBOL:
 ParsePrimitiveExpr
 ***********************************************************************/
 
-Ptr<Expr> ParsePrimitiveExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParsePrimitiveExpr(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	if (cursor)
 	{
@@ -422,33 +417,35 @@ Ptr<Expr> ParsePrimitiveExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cu
 ParsePostfixUnaryExpr
 ***********************************************************************/
 
-Ptr<Category_Id_Child_Generic_Expr> ParseFieldAccessNameExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Category_Id_Child_Generic_Expr> ParseFieldAccessNameExpr(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	auto oldCursor = cursor;
-	try
+	if (auto type = TryParseLongType(pa, cursor))
 	{
-		auto type = ParseLongType(pa, cursor);
-		RequireToken(cursor, CppTokens::COLON, CppTokens::COLON);
-		bool templateKeyword = false;
-		if (auto childExpr = TryParseChildExpr(pa, type, templateKeyword, cursor))
+		try
 		{
-			return TryParseGenericExpr(pa, cursor, childExpr, templateKeyword, false);
+			RequireToken(cursor, CppTokens::COLON, CppTokens::COLON);
+			bool templateKeyword = false;
+			if (auto childExpr = TryParseChildExpr(pa, type.Obj(), templateKeyword, cursor))
+			{
+				return TryParseGenericExpr(pa, cursor, childExpr.Obj(), templateKeyword, false);
+			}
 		}
+		catch (const StopParsingException&)
+		{
+		}
+		cursor = oldCursor;
 	}
-	catch (const StopParsingException&)
-	{
-	}
-	cursor = oldCursor;
 
 	auto idExpr = MakePtr<IdExpr>();
 	if (!ParseCppName(idExpr->name, cursor, false) && !ParseCppName(idExpr->name, cursor, true))
 	{
 		throw StopParsingException(cursor);
 	}
-	return TryParseGenericExpr(pa, cursor, idExpr, false, true);
+	return TryParseGenericExpr(pa, cursor, idExpr.Obj(), false, true);
 }
 
-Ptr<Expr> ParsePostfixUnaryExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParsePostfixUnaryExpr(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	Ptr<Expr> expr;
 	if (TestToken(cursor, CppTokens::NOEXCEPT, false))
@@ -601,22 +598,20 @@ Ptr<Expr> ParsePostfixUnaryExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>&
 ParsePrefixUnaryExpr
 ***********************************************************************/
 
-Ptr<Expr> ParsePrefixUnaryExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParsePrefixUnaryExpr(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::EXPR_SIZEOF))
 	{
 		auto newExpr = MakePtr<SizeofExpr>();
 		newExpr->ellipsis = TestToken(cursor, CppTokens::DOT, CppTokens::DOT, CppTokens::DOT);
 		auto oldCursor = cursor;
-		try
-		{
-			RequireToken(cursor, CppTokens::LPARENTHESIS);
-			newExpr->type = ParseType(pa, cursor);
-			RequireToken(cursor, CppTokens::RPARENTHESIS);
-			return newExpr;
-		}
-		catch (const StopParsingException&)
+		if (TestToken(cursor, CppTokens::LPARENTHESIS))
 		{
+			newExpr->type = TryParseType(pa, cursor);
+			if (newExpr->type && TestToken(cursor, CppTokens::RPARENTHESIS))
+			{
+				return newExpr;
+			}
 			newExpr->type = nullptr;
 			cursor = oldCursor;
 		}
@@ -726,16 +721,14 @@ Ptr<Expr> ParsePrefixUnaryExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>&
 	{
 		Ptr<Type> type;
 		auto oldCursor = cursor;
-		try
-		{
-			RequireToken(cursor, CppTokens::LPARENTHESIS);
-			type = ParseType(pa, cursor);
-			RequireToken(cursor, CppTokens::RPARENTHESIS);
-		}
-		catch (const StopParsingException&)
+		if (TestToken(cursor, CppTokens::LPARENTHESIS))
 		{
-			type = nullptr;
-			cursor = oldCursor;
+			type = TryParseType(pa, cursor);
+			if (!type || !TestToken(cursor, CppTokens::RPARENTHESIS))
+			{
+				type = nullptr;
+				cursor = oldCursor;
+			}
 		}
 
 		if (type)
@@ -757,7 +750,7 @@ Ptr<Expr> ParsePrefixUnaryExpr(const ParsingArguments& pa, Ptr<CppTokenCursor>&
 ParseBinaryExpr
 ***********************************************************************/
 
-Ptr<Expr> ParseBinaryExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParseBinaryExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor)
 {
 	List<Ptr<BinaryExpr>> binaryStack;
 	auto popped = ParsePrefixUnaryExpr(pa, cursor);
@@ -895,7 +888,7 @@ Ptr<Expr> ParseBinaryExpr(const ParsingArguments& pa, const ParsingExprArguments
 ParseIfExpr
 ***********************************************************************/
 
-Ptr<Expr> ParseIfExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParseIfExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor)
 {
 	auto expr = ParseBinaryExpr(pa, pea, cursor);
 	if (TestToken(cursor, CppTokens::QUESTIONMARK))
@@ -917,7 +910,7 @@ Ptr<Expr> ParseIfExpr(const ParsingArguments& pa, const ParsingExprArguments& pe
 ParseAssignExpr
 ***********************************************************************/
 
-Ptr<Expr> ParseAssignExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParseAssignExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor)
 {
 	auto expr = ParseIfExpr(pa, pea, cursor);
 	if (TestToken(cursor, CppTokens::EQ, false))
@@ -970,7 +963,7 @@ Ptr<Expr> ParseAssignExpr(const ParsingArguments& pa, const ParsingExprArguments
 ParseThrowExpr
 ***********************************************************************/
 
-Ptr<Expr> ParseThrowExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParseThrowExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::THROW))
 	{
@@ -991,7 +984,7 @@ Ptr<Expr> ParseThrowExpr(const ParsingArguments& pa, const ParsingExprArguments&
 ParseExpr
 ***********************************************************************/
 
-Ptr<Expr> ParseExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, Ptr<CppTokenCursor>& cursor)
+Ptr<Expr> ParseExpr(const ParsingArguments& pa, const ParsingExprArguments& pea, CppTokenCursor*& cursor)
 {
 	auto expr = ParseThrowExpr(pa, pea, cursor);
 	while (pea.allowComma)
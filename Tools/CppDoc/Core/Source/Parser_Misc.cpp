@@ -5,7 +5,7 @@
 SkipSpecifiers
 ***********************************************************************/
 
-bool SkipSpecifiers(Ptr<CppTokenCursor>& cursor)
+bool SkipSpecifiers(CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::LBRACKET, CppTokens::LBRACKET))
 	{
@@ -76,7 +76,7 @@ ParseCppName
 // operator new[]
 // operator delete
 // operator delete[]
-bool ParseCppName(CppName& name, Ptr<CppTokenCursor>& cursor, bool forceSpecialMethod)
+bool ParseCppName(CppName& name, CppTokenCursor*& cursor, bool forceSpecialMethod)
 {
 	if (TestToken(cursor, CppTokens::OPERATOR, false))
 	{
@@ -287,7 +287,7 @@ Ptr<Type> AdjustReturnTypeWithMemberAndCC(Ptr<FunctionType> functionType)
 ParseCallingConvention
 ***********************************************************************/
 
-bool ParseCallingConvention(TsysCallingConvention& callingConvention, Ptr<CppTokenCursor>& cursor)
+bool ParseCallingConvention(TsysCallingConvention& callingConvention, CppTokenCursor*& cursor)
 {
 #define CALLING_CONVENTION_KEYWORD(TOKEN, NAME)\
 	if (TestToken(cursor, CppTokens::TOKEN))\
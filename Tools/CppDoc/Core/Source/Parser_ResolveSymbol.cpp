@@ -54,7 +54,7 @@ struct ResolveSymbolArguments
 	SortedList<Symbol*> searchedScopes;									\
 	ResolveSymbolArguments rsa(name, input, found, searchedScopes)		\
 
-void ResolveChildSymbolInternal(const ParsingArguments& pa, Ptr<Type> classType, SearchPolicy policy, ResolveSymbolArguments& rsa);
+void ResolveChildSymbolInternal(const ParsingArguments& pa, Type* classType, SearchPolicy policy, ResolveSymbolArguments& rsa);
 
 /***********************************************************************
 AddSymbolToResolve
@@ -279,7 +279,7 @@ void ResolveSymbolInternal(const ParsingArguments& pa, SearchPolicy policy, Reso
 						auto baseType = currentClassDecl->baseTypes[i].f1;
 						ResolveChildSymbolInternal(
 							pa,
-							baseType,
+							baseType.Obj(),
 							(policy == SearchPolicy::ChildSymbolFromOutside ? SearchPolicy::ChildSymbolFromOutside : SearchPolicy::ChildSymbolFromSubClass),
 							rsa
 							);
@@ -317,6 +317,7 @@ ResolveSymbol
 
 ResolveSymbolResult ResolveSymbol(const ParsingArguments& pa, CppName& name, SearchPolicy policy, ResolveSymbolResult input)
 {
+	CountProfilerEvent(ProfilerCounter::ResolveSymbol);
 	PREPARE_RSA;
 	ResolveSymbolInternal(pa, policy, rsa);
 	return rsa.result;
@@ -433,7 +434,7 @@ public:
 	}
 };
 
-void ResolveChildSymbolInternal(const ParsingArguments& pa, Ptr<Type> classType, SearchPolicy policy, ResolveSymbolArguments& rsa)
+void ResolveChildSymbolInternal(const ParsingArguments& pa, Type* classType, SearchPolicy policy, ResolveSymbolArguments& rsa)
 {
 	ResolveChildSymbolTypeVisitor visitor(pa, policy, rsa);
 	classType->Accept(&visitor);
@@ -443,7 +444,7 @@ void ResolveChildSymbolInternal(const ParsingArguments& pa, Ptr<Type> classType,
 ResolveChildSymbol
 ***********************************************************************/
 
-ResolveSymbolResult ResolveChildSymbol(const ParsingArguments& pa, Ptr<Type> classType, CppName& name, ResolveSymbolResult input)
+ResolveSymbolResult ResolveChildSymbol(const ParsingArguments& pa, Type* classType, CppName& name, ResolveSymbolResult input)
 {
 	PREPARE_RSA;
 	ResolveChildSymbolInternal(pa, classType, SearchPolicy::ChildSymbolFromOutside, rsa);
@@ -3,22 +3,26 @@
 #include "Ast_Decl.h"
 
 template<typename T>
-void ParseVariableOrExpression(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<T> stat)
+void ParseVariableOrExpression(const ParsingArguments& pa, CppTokenCursor*& cursor, Ptr<T> stat)
 {
-	auto oldCursor = cursor;
 	Ptr<Declarator> declarator;
-	try
+	LongTypeLookahead lookahead;
+	if (IsPotentialLongType(pa, cursor, &lookahead))
 	{
-		declarator = ParseNonMemberDeclarator(pa, pda_VarInit(), cursor);
-		if (!declarator->initializer)
+		auto oldCursor = cursor;
+		try
 		{
-			throw StopParsingException(cursor);
+			declarator = ParseNonMemberDeclarator(pa, pda_VarInit(), cursor, &lookahead);
+			if (!declarator->initializer)
+			{
+				throw StopParsingException(cursor);
+			}
+		}
+		catch (const StopParsingException&)
+		{
+			declarator = nullptr;
+			cursor = oldCursor;
 		}
-	}
-	catch (const StopParsingException&)
-	{
-		declarator = nullptr;
-		cursor = oldCursor;
 	}
 
 	if (declarator)
@@ -31,7 +35,7 @@ void ParseVariableOrExpression(const ParsingArguments& pa, Ptr<CppTokenCursor>&
 	}
 }
 
-Ptr<Stat> ParseStat(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Stat> ParseStat(const ParsingArguments& pa, CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::SEMICOLON))
 	{
@@ -119,11 +123,17 @@ Ptr<Stat> ParseStat(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
 
 		{
 			// for (VARIABLE-DECLARATION : EXPRESSION) STATEMENT
+			LongTypeLookahead lookahead;
+			if (!IsPotentialLongType(pa, cursor, &lookahead))
+			{
+				goto FOR_EACH_FAILED;
+			}
+
 			auto oldCursor = cursor;
 			Ptr<Declarator> declarator;
 			try
 			{
-				declarator = ParseNonMemberDeclarator(pa, pda_VarNoInit(), cursor);
+				declarator = ParseNonMemberDeclarator(pa, pda_VarNoInit(), cursor, &lookahead);
 				RequireToken(cursor, CppTokens::COLON);
 			}
 			catch (const StopParsingException&)
@@ -152,16 +162,20 @@ Ptr<Stat> ParseStat(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
 			auto newPa = pa.WithScope(pa.scopeSymbol->CreateStatSymbol_NFb(stat));
 			if (!TestToken(cursor, CppTokens::SEMICOLON))
 			{
-				auto oldCursor = cursor;
 				List<Ptr<Declarator>> declarators;
-				try
-				{
-					ParseNonMemberDeclarator(newPa, pda_Decls(false, false), cursor, declarators);
-				}
-				catch (const StopParsingException&)
+				LongTypeLookahead lookahead;
+				if (IsPotentialLongType(newPa, cursor, &lookahead))
 				{
-					declarators.Clear();
-					cursor = oldCursor;
+					auto oldCursor = cursor;
+					try
+					{
+						ParseNonMemberDeclarator(newPa, pda_Decls(false, false), cursor, declarators, &lookahead);
+					}
+					catch (const StopParsingException&)
+					{
+						declarators.Clear();
+						cursor = oldCursor;
+					}
 				}
 
 				if (declarators.Count() > 0)
@@ -195,12 +209,14 @@ Ptr<Stat> ParseStat(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
 		auto stat = MakePtr<IfElseStat>();
 		auto newPa = pa.WithScope(pa.scopeSymbol->CreateStatSymbol_NFb(stat));
 		RequireToken(cursor, CppTokens::LPARENTHESIS);
+		LongTypeLookahead lookahead;
+		if (IsPotentialLongType(newPa, cursor, &lookahead))
 		{
 			auto oldCursor = cursor;
 			List<Ptr<Declarator>> declarators;
 			try
 			{
-				ParseNonMemberDeclarator(newPa, pda_Decls(false, false), cursor, declarators);
+				ParseNonMemberDeclarator(newPa, pda_Decls(false, false), cursor, declarators, &lookahead);
 				RequireToken(cursor, CppTokens::SEMICOLON);
 				BuildVariablesAndSymbols(newPa, declarators, stat->varDecls, cursor);
 			}
@@ -6,7 +6,7 @@
 ParseTemplateSpec
 ***********************************************************************/
 
-void ParseTemplateSpec(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<Symbol>& specSymbol, Ptr<TemplateSpec>& spec)
+void ParseTemplateSpec(const ParsingArguments& pa, CppTokenCursor*& cursor, Ptr<Symbol>& specSymbol, Ptr<TemplateSpec>& spec)
 {
 	RequireToken(cursor, CppTokens::DECL_TEMPLATE);
 	RequireToken(cursor, CppTokens::LT);
@@ -149,7 +149,7 @@ void ParseTemplateSpec(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor,
 ValidateForRootTemplateSpec
 ***********************************************************************/
 
-void ValidateForRootTemplateSpec(Ptr<TemplateSpec>& spec, Ptr<CppTokenCursor>& cursor)
+void ValidateForRootTemplateSpec(Ptr<TemplateSpec>& spec, CppTokenCursor*& cursor)
 {
 	for (vint i = 0; i < spec->arguments.Count() - 1; i++)
 	{
@@ -165,7 +165,7 @@ void ValidateForRootTemplateSpec(Ptr<TemplateSpec>& spec, Ptr<CppTokenCursor>& c
 ParseSpecializationSpec
 ***********************************************************************/
 
-void ParseSpecializationSpec(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, Ptr<SpecializationSpec>& spec)
+void ParseSpecializationSpec(const ParsingArguments& pa, CppTokenCursor*& cursor, Ptr<SpecializationSpec>& spec)
 {
 	if (TestToken(cursor, CppTokens::LT))
 	{
@@ -179,7 +179,7 @@ void ParseSpecializationSpec(const ParsingArguments& pa, Ptr<CppTokenCursor>& cu
 ParseGenericArgumentsSkippedLT
 ***********************************************************************/
 
-void ParseGenericArgumentsSkippedLT(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor, VariadicList<GenericArgument>& arguments, CppTokens ending)
+void ParseGenericArgumentsSkippedLT(const ParsingArguments& pa, CppTokenCursor*& cursor, VariadicList<GenericArgument>& arguments, CppTokens ending)
 {
 	// { TYPE/EXPR ...} >
 	while (!TestToken(cursor, ending))
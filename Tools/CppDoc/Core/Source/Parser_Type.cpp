@@ -6,7 +6,7 @@
 ParsePrimitiveType
 ***********************************************************************/
 
-Ptr<Type> ParsePrimitiveType(Ptr<CppTokenCursor>& cursor, CppPrimitivePrefix prefix)
+Ptr<Type> ParsePrimitiveType(CppTokenCursor*& cursor, CppPrimitivePrefix prefix)
 {
 #define TEST_SINGLE_KEYWORD(TOKEN, KEYWORD)\
 	if (TestToken(cursor, CppTokens::TOKEN)) return MakePtr<PrimitiveType>(prefix, CppPrimitiveType::_##KEYWORD)
@@ -52,8 +52,11 @@ Ptr<Type> ParsePrimitiveType(Ptr<CppTokenCursor>& cursor, CppPrimitivePrefix pre
 ParseIdType
 ***********************************************************************/
 
-Ptr<IdType> ParseIdType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, Ptr<CppTokenCursor>& cursor)
+Ptr<IdType> ParseIdType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead)
 {
+	// reuse types resolved by IsPotentialLongType if the name starts at the same token
+	bool useLookahead = lookahead && lookahead->idCursor && lookahead->idCursor == cursor;
+
 	auto idKind = cursor ? (CppTokens)cursor->token.token : CppTokens::ID;
 
 	// check if this is a c style type reference, e.g. struct something
@@ -67,7 +70,7 @@ Ptr<IdType> ParseIdType(const ParsingArguments& pa, ShortTypeTypenameKind typena
 	if (ParseCppName(type->name, cursor))
 	{
 		auto policy = type->cStyleTypeReference ? SearchPolicy::SymbolAccessableInScope_CStyleTypeReference : SearchPolicy::SymbolAccessableInScope;
-		if (auto resolving = ResolveSymbol(pa, type->name, policy).types)
+		if (auto resolving = useLookahead ? lookahead->idTypes : ResolveSymbol(pa, type->name, policy).types)
 		{
 			type->resolving = resolving;
 			if (pa.recorder)
@@ -186,7 +189,7 @@ Ptr<IdType> ParseIdType(const ParsingArguments& pa, ShortTypeTypenameKind typena
 TryParseChildType
 ***********************************************************************/
 
-Ptr<ChildType> TryParseChildType(const ParsingArguments& pa, Ptr<Category_Id_Child_Generic_Root_Type> classType, ShortTypeTypenameKind typenameKind, bool& templateKeyword, Ptr<CppTokenCursor>& cursor)
+Ptr<ChildType> TryParseChildType(const ParsingArguments& pa, Category_Id_Child_Generic_Root_Type* classType, ShortTypeTypenameKind typenameKind, bool& templateKeyword, CppTokenCursor*& cursor)
 {
 	if ((templateKeyword = TestToken(cursor, CppTokens::DECL_TEMPLATE)))
 	{
@@ -232,7 +235,7 @@ Ptr<ChildType> TryParseChildType(const ParsingArguments& pa, Ptr<Category_Id_Chi
 TryParseGenericType
 ***********************************************************************/
 
-Ptr< Category_Id_Child_Generic_Root_Type> TryParseGenericType(const ParsingArguments& pa, Ptr<Category_Id_Child_Type> classType, Ptr<CppTokenCursor>& cursor)
+Ptr< Category_Id_Child_Generic_Root_Type> TryParseGenericType(const ParsingArguments& pa, Category_Id_Child_Type* classType, CppTokenCursor*& cursor)
 {
 	if (TestToken(cursor, CppTokens::LT))
 	{
@@ -248,20 +251,53 @@ Ptr< Category_Id_Child_Generic_Root_Type> TryParseGenericType(const ParsingArgum
 	}
 }
 
+/***********************************************************************
+IntrinsicTypeName
+***********************************************************************/
+
+// names of compiler intrinsic types that are parsed in ParseNameType instead of being resolved as symbols
+#define INTRINSIC_TYPE_NAME_LIST(F)\
+	F(MakeIntegerSeq, __make_integer_seq)\
+	F(UnderlyingType, __underlying_type)\
+
+enum class IntrinsicTypeName
+{
+	None,
+#define DEFINE_INTRINSIC_TYPE_NAME(NAME, INTRINSIC_NAME) NAME,
+	INTRINSIC_TYPE_NAME_LIST(DEFINE_INTRINSIC_TYPE_NAME)
+#undef DEFINE_INTRINSIC_TYPE_NAME
+};
+
+IntrinsicTypeName GetIntrinsicTypeName(CppTokenCursor* cursor)
+{
+	auto& token = cursor->token;
+#define MATCH_INTRINSIC_TYPE_NAME(NAME, INTRINSIC_NAME)\
+	{\
+		const vint length = sizeof(L#INTRINSIC_NAME) / sizeof(wchar_t) - 1;\
+		if (token.length == length && wcsncmp(token.reading, L#INTRINSIC_NAME, length) == 0) return IntrinsicTypeName::NAME;\
+	}\
+
+	INTRINSIC_TYPE_NAME_LIST(MATCH_INTRINSIC_TYPE_NAME)
+#undef MATCH_INTRINSIC_TYPE_NAME
+	return IntrinsicTypeName::None;
+}
+
+#undef INTRINSIC_TYPE_NAME_LIST
+
 /***********************************************************************
 ParseNameType
 ***********************************************************************/
 
-Ptr<Type> ParseNameType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, Ptr<CppTokenCursor>& cursor)
+Ptr<Type> ParseNameType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead)
 {
 	bool templateKeyword = false;
 	Ptr<Category_Id_Child_Generic_Root_Type> typeResult;
 	if (TestToken(cursor, CppTokens::COLON, CppTokens::COLON))
 	{
 		// :: NAME
-		if (auto type = TryParseChildType(pa, MakePtr<RootType>(), ShortTypeTypenameKind::No, templateKeyword, cursor))
+		if (auto type = TryParseChildType(pa, MakePtr<RootType>().Obj(), ShortTypeTypenameKind::No, templateKeyword, cursor))
 		{
-			typeResult = TryParseGenericType(pa, type, cursor);
+			typeResult = TryParseGenericType(pa, type.Obj(), cursor);
 		}
 		else
 		{
@@ -272,54 +308,48 @@ Ptr<Type> ParseNameType(const ParsingArguments& pa, ShortTypeTypenameKind typena
 	{
 		if (TestToken(cursor, CppTokens::ID, false))
 		{
-#define DEFINE_INTRINSIC_NAME(INTRINSIC_NAME)																		\
-			static const wchar_t	NAME##INTRINSIC_NAME[]	= L#INTRINSIC_NAME;										\
-			static const vint		SIZE##INTRINSIC_NAME	= sizeof(NAME##INTRINSIC_NAME) / sizeof(wchar_t) - 1	\
-
-#define MATCH_INTRINSIC_NAME(INTRINSIC_NAME) cursor->token.length == SIZE##INTRINSIC_NAME && wcsncmp(cursor->token.reading, NAME##INTRINSIC_NAME, SIZE##INTRINSIC_NAME) == 0
-
-			DEFINE_INTRINSIC_NAME(__make_integer_seq);
-			DEFINE_INTRINSIC_NAME(__underlying_type);
-
-			if (MATCH_INTRINSIC_NAME(__make_integer_seq))
+			switch (GetIntrinsicTypeName(cursor))
 			{
-				SkipToken(cursor);
-				RequireToken(cursor, CppTokens::LT);
-				auto sequenceType = ParseIdType(pa, ShortTypeTypenameKind::Implicit, cursor);
-				RequireToken(cursor, CppTokens::COMMA);
-				auto elementType = ParseType(pa, cursor);
-				RequireToken(cursor, CppTokens::COMMA);
-				ParseExpr(pa, pea_GenericArgument(), cursor);
-				RequireToken(cursor, CppTokens::GT);
-
-				auto genericType = MakePtr<GenericType>();
-				genericType->type = sequenceType;
-
-				VariadicItem<GenericArgument> argument;
-				argument.isVariadic = false;
-				argument.item.type = elementType;
-				genericType->arguments.Add(argument);
-
-				typeResult = genericType;
-				goto SKIP_NORMAL_PARSING;
-			}
-			else if (MATCH_INTRINSIC_NAME(__underlying_type))
-			{
-				SkipToken(cursor);
-				RequireToken(cursor, CppTokens::LPARENTHESIS);
-				ParseType(pa, cursor);
-				RequireToken(cursor, CppTokens::RPARENTHESIS);
-
-				auto intType = MakePtr<PrimitiveType>();
-				intType->prefix = CppPrimitivePrefix::_none;
-				intType->primitive = CppPrimitiveType::_int;
-				return intType;
+			case IntrinsicTypeName::MakeIntegerSeq:
+				{
+					SkipToken(cursor);
+					RequireToken(cursor, CppTokens::LT);
+					auto sequenceType = ParseIdType(pa, ShortTypeTypenameKind::Implicit, cursor, nullptr);
+					RequireToken(cursor, CppTokens::COMMA);
+					auto elementType = ParseType(pa, cursor);
+					RequireToken(cursor, CppTokens::COMMA);
+					ParseExpr(pa, pea_GenericArgument(), cursor);
+					RequireToken(cursor, CppTokens::GT);
+
+					auto genericType = MakePtr<GenericType>();
+					genericType->type = sequenceType;
+
+					VariadicItem<GenericArgument> argument;
+					argument.isVariadic = false;
+					argument.item.type = elementType;
+					genericType->arguments.Add(argument);
+
+					typeResult = genericType;
+					goto SKIP_NORMAL_PARSING;
+				}
+			case IntrinsicTypeName::UnderlyingType:
+				{
+					SkipToken(cursor);
+					RequireToken(cursor, CppTokens::LPARENTHESIS);
+					ParseType(pa, cursor);
+					RequireToken(cursor, CppTokens::RPARENTHESIS);
+
+					auto intType = MakePtr<PrimitiveType>();
+					intType->prefix = CppPrimitivePrefix::_none;
+					intType->primitive = CppPrimitiveType::_int;
+					return intType;
+				}
+			default:
+				break;
 			}
-#undef MATCH_INTRINSIC_NAME
-#undef DEFINE_INTRINSIC_NAME
 		}
 		// NAME
-		typeResult = TryParseGenericType(pa, ParseIdType(pa, typenameKind, cursor), cursor);
+		typeResult = TryParseGenericType(pa, ParseIdType(pa, typenameKind, cursor, lookahead).Obj(), cursor);
 	SKIP_NORMAL_PARSING:;
 	}
 
@@ -333,9 +363,9 @@ Ptr<Type> ParseNameType(const ParsingArguments& pa, ShortTypeTypenameKind typena
 			{
 				throw StopParsingException(cursor);
 			}
-			if (auto type = TryParseChildType(pa, typeResult, typenameKind, templateKeyword, cursor))
+			if (auto type = TryParseChildType(pa, typeResult.Obj(), typenameKind, templateKeyword, cursor))
 			{
-				typeResult = TryParseGenericType(pa, type, cursor);
+				typeResult = TryParseGenericType(pa, type.Obj(), cursor);
 				continue;
 			}
 		}
@@ -348,7 +378,7 @@ Ptr<Type> ParseNameType(const ParsingArguments& pa, ShortTypeTypenameKind typena
 ParseShortType
 ***********************************************************************/
 
-Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, Ptr<CppTokenCursor>& cursor)
+Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead)
 {
 	if (TestToken(cursor, CppTokens::SIGNED))
 	{
@@ -375,7 +405,7 @@ Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typen
 	else if (TestToken(cursor, CppTokens::CONST))
 	{
 		// const TYPE
-		auto type = ParseShortType(pa, typenameKind, cursor);
+		auto type = ParseShortType(pa, typenameKind, cursor, lookahead);
 		auto dt = type.Cast<DecorateType>();
 		if (!dt)
 		{
@@ -388,7 +418,7 @@ Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typen
 	else if (TestToken(cursor, CppTokens::VOLATILE))
 	{
 		// volatile TYPE
-		auto type = ParseShortType(pa, typenameKind, cursor);
+		auto type = ParseShortType(pa, typenameKind, cursor, lookahead);
 		auto dt = type.Cast<DecorateType>();
 		if (!dt)
 		{
@@ -400,7 +430,7 @@ Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typen
 	}
 	else if (TestToken(cursor, CppTokens::TYPENAME))
 	{
-		return ParseShortType(pa, ShortTypeTypenameKind::Yes, cursor);
+		return ParseShortType(pa, ShortTypeTypenameKind::Yes, cursor, lookahead);
 	}
 	else
 	{
@@ -410,20 +440,25 @@ Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typen
 			if (result) return result;
 		}
 
-		return ParseNameType(pa, typenameKind, cursor);
+		return ParseNameType(pa, typenameKind, cursor, lookahead);
 	}
 }
 
+Ptr<Type> ParseShortType(const ParsingArguments& pa, ShortTypeTypenameKind typenameKind, CppTokenCursor*& cursor)
+{
+	return ParseShortType(pa, typenameKind, cursor, nullptr);
+}
+
 /***********************************************************************
 ParseLongType
 ***********************************************************************/
 
-Ptr<Type> ParseLongType(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
+Ptr<Type> ParseLongType(const ParsingArguments& pa, CppTokenCursor*& cursor, const LongTypeLookahead* lookahead)
 {
 	Ptr<Type> typeResult;
 	{
 		bool typenameType = TestToken(cursor, CppTokens::TYPENAME);
-		typeResult = ParseShortType(pa, (typenameType ? ShortTypeTypenameKind::Yes : ShortTypeTypenameKind::No), cursor);
+		typeResult = ParseShortType(pa, (typenameType ? ShortTypeTypenameKind::Yes : ShortTypeTypenameKind::No), cursor, lookahead);
 	}
 
 	while (true)
@@ -459,4 +494,76 @@ Ptr<Type> ParseLongType(const ParsingArguments& pa, Ptr<CppTokenCursor>& cursor)
 	}
 
 	return typeResult;
+}
+
+/***********************************************************************
+IsPotentialLongType
+***********************************************************************/
+
+// returns false only when ParseLongType (so as ParseType) fails at the first token without any side effect
+// callers use it to skip a speculative parsing that would end up in a StopParsingException
+// types resolved from a leading identifier are stored in lookahead, passing it to ParseLongType avoids resolving the name again
+bool IsPotentialLongType(const ParsingArguments& pa, CppTokenCursor* cursor, LongTypeLookahead* lookahead)
+{
+	if (!cursor) return false;
+
+	switch ((CppTokens)cursor->token.token)
+	{
+	case CppTokens::ID:
+		{
+			// intrinsic names are handled in ParseNameType
+			if (GetIntrinsicTypeName(cursor) != IntrinsicTypeName::None) return true;
+
+			auto idCursor = cursor;
+			CppName cppName;
+			ParseCppName(cppName, cursor);
+			auto types = ResolveSymbol(pa, cppName, SearchPolicy::SymbolAccessableInScope).types;
+			if (lookahead)
+			{
+				lookahead->idCursor = idCursor;
+				lookahead->idTypes = types;
+			}
+			return types;
+		}
+	case CppTokens::TYPENAME:
+	case CppTokens::SIGNED:
+	case CppTokens::UNSIGNED:
+	case CppTokens::DECLTYPE:
+	case CppTokens::CONST:
+	case CppTokens::VOLATILE:
+	case CppTokens::COLON:
+	case CppTokens::DECL_ENUM:
+	case CppTokens::DECL_CLASS:
+	case CppTokens::DECL_STRUCT:
+	case CppTokens::DECL_UNION:
+	case CppTokens::OPERATOR:
+		return true;
+	default:
+		return ParsePrimitiveType(cursor, CppPrimitivePrefix::_none);
+	}
+}
+
+/***********************************************************************
+TryParseLongType
+***********************************************************************/
+
+// returns nullptr and keeps the cursor unchanged if there is no type at the cursor
+Ptr<Type> TryParseLongType(const ParsingArguments& pa, CppTokenCursor*& cursor)
+{
+	LongTypeLookahead lookahead;
+	if (!IsPotentialLongType(pa, cursor, &lookahead))
+	{
+		return nullptr;
+	}
+
+	auto oldCursor = cursor;
+	try
+	{
+		return ParseLongType(pa, cursor, &lookahead);
+	}
+	catch (const StopParsingException&)
+	{
+		cursor = oldCursor;
+		return nullptr;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "Profiler.h"
+
+using namespace vl::stream;
+
+vint profilerCounters[(vint)ProfilerCounter::Max] = { 0 };
+
+const wchar_t* GetProfilerCounterName(ProfilerCounter counter)
+{
+	switch (counter)
+	{
+	case ProfilerCounter::CppObjectCreated:				return L"CppObjectCreated";
+	case ProfilerCounter::TsysCreated:					return L"TsysCreated";
+	case ProfilerCounter::ResolveSymbol:				return L"ResolveSymbol";
+	case ProfilerCounter::TestTypeConversion:			return L"TestTypeConversion";
+	case ProfilerCounter::TypeConvCacheHit:				return L"TypeConvCacheHit";
+	case ProfilerCounter::InferFunctionType:			return L"InferFunctionType";
+	case ProfilerCounter::EvaluateClassSymbol:			return L"EvaluateClassSymbol";
+	case ProfilerCounter::ExpandPotentialVta:			return L"ExpandPotentialVta";
+	case ProfilerCounter::GenericCacheHit:				return L"GenericCacheHit";
+	case ProfilerCounter::GenericCacheMiss:				return L"GenericCacheMiss";
+	case ProfilerCounter::CartesianProductOverLimit:	return L"CartesianProductOverLimit";
+	default:											return L"";
+	}
+}
+
+/***********************************************************************
+Profiler
+***********************************************************************/
+
+void Profiler::BeginPhase(const WString& name)
+{
+	if (currentPhase)
+	{
+		EndPhase();
+	}
+
+	currentPhase = MakePtr<ProfilerPhase>();
+	currentPhase->name = name;
+	currentPhase->startMilliseconds = DateTime::UtcTime().totalMilliseconds;
+	for (vint i = 0; i < (vint)ProfilerCounter::Max; i++)
+	{
+		currentPhase->counters[i] = profilerCounters[i];
+	}
+}
+
+void Profiler::EndPhase()
+{
+	if (!currentPhase) return;
+
+	currentPhase->milliseconds = DateTime::UtcTime().totalMilliseconds - currentPhase->startMilliseconds;
+	for (vint i = 0; i < (vint)ProfilerCounter::Max; i++)
+	{
+		currentPhase->counters[i] = profilerCounters[i] - currentPhase->counters[i];
+	}
+	phases.Add(currentPhase);
+	currentPhase = nullptr;
+}
+
+void Profiler::AddGenericCache(const ProfilerGenericCache& genericCache)
+{
+	genericCaches.Add(genericCache);
+}
+
+void Profiler::WriteReport(const FilePath& pathReport)
+{
+	EndPhase();
+
+	auto writeHitRate = [](StreamWriter& writer, const wchar_t* name, vint hits, vint total, bool last)
+	{
+		writer.WriteString(L"    \"");
+		writer.WriteString(name);
+		writer.WriteString(L"\": ");
+		writer.WriteString(total == 0 ? WString(L"0") : ftow((double)hits / (double)total));
+		writer.WriteLine(last ? L"" : L",");
+	};
+
+	FileStream fileStream(pathReport.GetFullPath(), FileStream::WriteOnly);
+	Utf8Encoder encoder;
+	EncoderStream encoderStream(fileStream, encoder);
+	StreamWriter writer(encoderStream);
+
+	vint totals[(vint)ProfilerCounter::Max] = { 0 };
+	vuint64_t totalMilliseconds = 0;
+
+	writer.WriteLine(L"{");
+	writer.WriteLine(L"  \"phases\": [");
+	FOREACH_INDEXER(Ptr<ProfilerPhase>, phase, phaseIndex, phases)
+	{
+		totalMilliseconds += phase->milliseconds;
+		writer.WriteLine(L"    {");
+		writer.WriteLine(L"      \"name\": \"" + phase->name + L"\",");
+		writer.WriteLine(L"      \"milliseconds\": " + u64tow(phase->milliseconds) + L",");
+		writer.WriteLine(L"      \"counters\": {");
+		for (vint i = 0; i < (vint)ProfilerCounter::Max; i++)
+		{
+			totals[i] += phase->counters[i];
+			writer.WriteString(L"        \"" + WString(GetProfilerCounterName((ProfilerCounter)i)) + L"\": " + itow(phase->counters[i]));
+			writer.WriteLine(i == (vint)ProfilerCounter::Max - 1 ? L"" : L",");
+		}
+		writer.WriteLine(L"      }");
+		writer.WriteLine(phaseIndex == phases.Count() - 1 ? L"    }" : L"    },");
+	}
+	writer.WriteLine(L"  ],");
+
+	writer.WriteLine(L"  \"total\": {");
+	writer.WriteLine(L"    \"milliseconds\": " + u64tow(totalMilliseconds) + L",");
+	writer.WriteLine(L"    \"counters\": {");
+	for (vint i = 0; i < (vint)ProfilerCounter::Max; i++)
+	{
+		writer.WriteString(L"      \"" + WString(GetProfilerCounterName((ProfilerCounter)i)) + L"\": " + itow(totals[i]));
+		writer.WriteLine(i == (vint)ProfilerCounter::Max - 1 ? L"" : L",");
+	}
+	writer.WriteLine(L"    }");
+	writer.WriteLine(L"  },");
+
+	writer.WriteLine(L"  \"cacheHitRates\": {");
+	writeHitRate(
+		writer,
+		L"TypeConvCache",
+		totals[(vint)ProfilerCounter::TypeConvCacheHit],
+		totals[(vint)ProfilerCounter::TestTypeConversion],
+		false
+	);
+	writeHitRate(
+		writer,
+		L"GenericCaches",
+		totals[(vint)ProfilerCounter::GenericCacheHit],
+		totals[(vint)ProfilerCounter::GenericCacheHit] + totals[(vint)ProfilerCounter::GenericCacheMiss],
+		true
+	);
+	writer.WriteLine(L"  },");
+
+	writer.WriteLine(L"  \"genericCaches\": [");
+	FOREACH_INDEXER(ProfilerGenericCache, genericCache, index, genericCaches)
+	{
+		writer.WriteString(L"    { \"symbol\": \"");
+		for (vint i = 0; i < genericCache.symbol.Length(); i++)
+		{
+			auto c = genericCache.symbol[i];
+			if (c == L'\"' || c == L'\\') writer.WriteChar(L'\\');
+			writer.WriteChar(c);
+		}
+		writer.WriteString(L"\", \"instantiations\": " + itow(genericCache.instantiations));
+		writer.WriteString(L", \"hits\": " + itow(genericCache.hits));
+		writer.WriteString(L", \"misses\": " + itow(genericCache.misses));
+		writer.WriteLine(index == genericCaches.Count() - 1 ? L" }" : L" },");
+	}
+	writer.WriteLine(L"  ]");
+	writer.WriteString(L"}");
+}
\ No newline at end of file
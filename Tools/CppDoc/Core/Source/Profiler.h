@@ -0,0 +1,74 @@
+#ifndef VCZH_DOCUMENT_CPPDOC_PROFILER
+#define VCZH_DOCUMENT_CPPDOC_PROFILER
+
+#include <VlppOS.h>
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::filesystem;
+
+/***********************************************************************
+Counters
+***********************************************************************/
+
+enum class ProfilerCounter
+{
+	CppObjectCreated,
+	TsysCreated,
+	ResolveSymbol,
+	TestTypeConversion,
+	TypeConvCacheHit,
+	InferFunctionType,
+	EvaluateClassSymbol,
+	ExpandPotentialVta,
+	GenericCacheHit,
+	GenericCacheMiss,
+	CartesianProductOverLimit,
+	Max,
+};
+
+extern vint										profilerCounters[(vint)ProfilerCounter::Max];
+extern const wchar_t*								GetProfilerCounterName(ProfilerCounter counter);
+
+inline void CountProfilerEvent(ProfilerCounter counter)
+{
+	// compiling is single-threaded, counters are updated on hot paths so they are not atomic
+	profilerCounters[(vint)counter]++;
+}
+
+/***********************************************************************
+Profiler
+***********************************************************************/
+
+struct ProfilerPhase
+{
+	WString											name;
+	vuint64_t										startMilliseconds = 0;
+	vuint64_t										milliseconds = 0;
+	vint											counters[(vint)ProfilerCounter::Max] = { 0 };
+};
+
+// instantiation statistics of a template symbol
+struct ProfilerGenericCache
+{
+	WString											symbol;
+	vint											instantiations = 0;
+	vint											hits = 0;
+	vint											misses = 0;
+};
+
+class Profiler : public Object
+{
+protected:
+	List<Ptr<ProfilerPhase>>						phases;
+	Ptr<ProfilerPhase>								currentPhase;
+	List<ProfilerGenericCache>						genericCaches;
+
+public:
+	void											BeginPhase(const WString& name);
+	void											EndPhase();
+	void											AddGenericCache(const ProfilerGenericCache& genericCache);
+	void											WriteReport(const FilePath& pathReport);
+};
+
+#endif
\ No newline at end of file
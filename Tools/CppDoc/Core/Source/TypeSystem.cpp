@@ -14,36 +14,49 @@ TsysBase
 ***********************************************************************/
 
 template<typename TType, typename TData>
-struct WithParams
+class WithParamsTable
 {
-	IEnumerable<ITsys*>*	params;
-	TType*					itsys;
-	TData					data;
+protected:
+	// the hash of each interned type is stored with it so that growing doesn't recompute it
+	struct Entry
+	{
+		vuint						hash;
+		TType*						itsys;
+	};
 
-	static vint Compare(const WithParams<TType, TData>& a, const WithParams<TType, TData>& b)
+	List<Entry>						entries;
+	HashBuckets						buckets;
+
+public:
+	static vuint Hash(IEnumerable<ITsys*>& params, const TData& data)
 	{
-		vint result = TData::Compare(a.data, b.data);
-		if (result != 0) return result;
-		return CompareEnumerable(*a.params, *b.params);
+		vuint hash = TData::Hash(data);
+		FOREACH(ITsys*, param, params)
+		{
+			hash = HashCombine(hash, (vuint)param);
+		}
+		return hash;
 	}
-};
-#define OPERATOR_COMPARE(OP)\
-	template<typename TType, typename TData>\
-	bool operator OP(const WithParams<TType, TData>& a, const WithParams<TType, TData>& b)\
-	{\
-		return WithParams<TType, TData>::Compare(a, b) OP 0;\
-	}\
-
-OPERATOR_COMPARE(>)
-OPERATOR_COMPARE(>=)
-OPERATOR_COMPARE(<)
-OPERATOR_COMPARE(<=)
-OPERATOR_COMPARE(==)
-OPERATOR_COMPARE(!=)
-#undef OPERATOR_COMPARE
 
-template<typename TType, typename TData>
-using WithParamsList = SortedList<WithParams<TType, TData>>;
+	TType* Get(vuint hash, IEnumerable<ITsys*>& params, const TData& data)
+	{
+		vint index = buckets.Find(hash, [&](vint i)
+		{
+			auto& entry = entries[i];
+			return entry.hash == hash && TData::Compare(entry.itsys->GetData(), data) == 0 && CompareEnumerable(entry.itsys->GetParams(), params) == 0;
+		});
+		return index == -1 ? nullptr : entries[index].itsys;
+	}
+
+	void Add(vuint hash, TType* itsys)
+	{
+		entries.Add({ hash,itsys });
+		buckets.AddLast(entries.Count(), 16, [&](vint i)
+		{
+			return entries[i].hash;
+		});
+	}
+};
 
 class TsysBase : public ITsys
 {
@@ -52,30 +65,70 @@ class TsysBase : public ITsys
 	TSYS_TYPE_LIST(DEFINE_TSYS_TYPE)
 #undef DEFINE_TSYS_TYPE
 protected:
+	// most types never have arrays, member pointers or functions derived from them, so these tables are allocated on the first use
+	struct DerivedTables
+	{
+		Dictionary<vint, ITsys_Array*>									arrayOf;
+		Dictionary<ITsys*, ITsys_Member*>								memberOf;
+		WithParamsTable<ITsys_Function, TsysFunc>						functionOf;
+		WithParamsTable<ITsys_GenericFunction, TsysGenericFunction>		genericFunctionOf;
+	};
+
 	TsysAlloc*														tsys;
 	ITsys_LRef*														lrefOf = nullptr;
 	ITsys_RRef*														rrefOf = nullptr;
 	ITsys_Ptr*														ptrOf = nullptr;
-	Dictionary<vint, ITsys_Array*>									arrayOf;
-	Dictionary<ITsys*, ITsys_Member*>								memberOf;
 	ITsys_CV*														cvOf[3] = { 0 };
-	WithParamsList<ITsys_Function, TsysFunc>						functionOf;
-	WithParamsList<ITsys_GenericFunction, TsysGenericFunction>		genericFunctionOf;
+	DerivedTables*													derivedTables = nullptr;
 
-	virtual ITsys* GetEntityInternal(TsysCV& cv, TsysRefType& refType)
+	DerivedTables& GetDerivedTables()
 	{
-		return this;
+		if (!derivedTables) derivedTables = new DerivedTables;
+		return *derivedTables;
+	}
+
+	void SetElement(ITsys* _element)
+	{
+		element = _element;
+	}
+
+	void SetEntityOfReference(TsysRefType refType)
+	{
+		// T& && and T&& & have been collapsed by LRefOf and RRefOf, so the innermost reference wins
+		entity = element->GetEntity(cv, entityRefType);
+		if (entityRefType == TsysRefType::None)
+		{
+			entityRefType = refType;
+		}
+	}
+
+	void SetEntityOfCV(TsysCV data)
+	{
+		entity = element->GetEntity(cv, entityRefType);
+		if (!cv.isGeneralConst && !cv.isVolatile)
+		{
+			cv = data;
+		}
+	}
+
+	void SetParams(IEnumerable<ITsys*>& _params, List<ITsys*>& params)
+	{
+		CopyFrom(params, _params);
+		paramCount = (vint32_t)params.Count();
+		paramBuffer = params.Count() == 0 ? nullptr : &params[0];
 	}
 
 public:
-	TsysBase(TsysAlloc* _tsys) :tsys(_tsys) {}
+	TsysBase(TsysAlloc* _tsys, TsysType _type) :ITsys(_type), tsys(_tsys) {}
+
+	~TsysBase()
+	{
+		if (derivedTables) delete derivedTables;
+	}
 
 	TsysPrimitive													GetPrimitive()				{ throw L"Not Implemented!"; }
-	TsysCV															GetCV()						{ throw L"Not Implemented!"; }
-	ITsys*															GetElement()				{ throw L"Not Implemented!"; }
+	vint															GetArrayDimensions()		{ throw L"Not Implemented!"; }
 	ITsys*															GetClass()					{ throw L"Not Implemented!"; }
-	ITsys*															GetParam(vint index)		{ throw L"Not Implemented!"; }
-	vint															GetParamCount()				{ throw L"Not Implemented!"; }
 	TsysFunc														GetFunc()					{ throw L"Not Implemented!"; }
 	const TsysInit&													GetInit()					{ throw L"Not Implemented!"; }
 	const TsysGenericFunction&										GetGenericFunction()		{ throw L"Not Implemented!"; }
@@ -93,13 +146,6 @@ public:
 	ITsys* GenericFunctionOf(IEnumerable<ITsys*>& params, const TsysGenericFunction& genericFunction)	override;
 	ITsys* GenericArgOf(TsysGenericArg genericArg)														override { throw L"Not Implemented!"; }
 
-	ITsys* GetEntity(TsysCV& cv, TsysRefType& refType)override
-	{
-		cv = { false,false };
-		refType = TsysRefType::None;
-		return GetEntityInternal(cv, refType);
-	}
-
 	bool IsUnknownType()override
 	{
 		return false;
@@ -115,9 +161,7 @@ template<TsysType Type>
 class TsysBase_ : public TsysBase
 {
 public:
-	TsysBase_(TsysAlloc* _tsys) :TsysBase(_tsys) {}
-
-	TsysType GetType()override { return Type; }
+	TsysBase_(TsysAlloc* _tsys) :TsysBase(_tsys, Type) {}
 };
 
 bool IsGenericArgInContext(const ParsingArguments& pa, ITsys* key)
@@ -135,20 +179,14 @@ Concrete Tsys (Commons Members)
 #define ITSYS_HAS_GENERIC_TYPE(VALUE)	public: bool HasGenericArg(const ParsingArguments& pa)override { return VALUE; }
 #define ITSYS_HAS_UNKNOWN_TYPE(VALUE)	public: bool HasUnknownType()override { return VALUE; }
 
-#define ITSYS_MEMBERS_WITHELEMENT_SHARED															\
-	protected:																						\
-		TsysBase*			element;																\
-	public:																							\
-		ITsys* GetElement()override { return element; }												\
-
 #define ITSYS_MEMBERS_WITHPARAMS_SHARED(TYPE, DATA, DATA_RET, NAME)									\
 	protected:																						\
 		List<ITsys*>		params;																	\
 		DATA				data;																	\
 	public:																							\
 		List<ITsys*>& GetParams() { return params; }												\
-		ITsys* GetParam(vint index)override { return params.Get(index); }							\
-		vint GetParamCount()override { return params.Count(); }										\
+		const DATA& GetData() { return data; }														\
+		void SetParams(IEnumerable<ITsys*>& _params) { TsysBase::SetParams(_params, params); }		\
 		DATA_RET Get##NAME()override { return data; }												\
 
 /***********************************************************************
@@ -167,28 +205,23 @@ Concrete Tsys (Members)
 		DATA Get##NAME()override { return data; }													\
 
 #define ITSYS_MEMBERS_REF(TYPE)																		\
-	ITSYS_MEMBERS_WITHELEMENT_SHARED																\
 	public:																							\
 		ITsys_##TYPE(TsysAlloc* _tsys, TsysBase* _element)											\
-			:TsysBase_(_tsys), element(_element) {}													\
+			:TsysBase_(_tsys) { SetElement(_element); }												\
 
 #define ITSYS_MEMBERS_DATA_WITHELEMENT(TYPE, DATA, NAME)											\
-	ITSYS_MEMBERS_WITHELEMENT_SHARED																\
 	protected:																						\
 		DATA				data;																	\
 	public:																							\
 		ITsys_##TYPE(TsysAlloc* _tsys, TsysBase* _element, DATA const& _data)						\
-			:TsysBase_(_tsys), element(_element), data(_data) {}									\
+			:TsysBase_(_tsys), data(_data) { SetElement(_element); }								\
 		DATA Get##NAME()override { return data; }													\
 
 #define ITSYS_MEMBERS_WITHPARAMS_WITH_ELEMENT(TYPE, DATA, DATA_RET, NAME)							\
 	ITSYS_MEMBERS_WITHPARAMS_SHARED(TYPE, DATA, DATA_RET, NAME)										\
-	protected:																						\
-		TsysBase*			element;																\
 	public:																							\
 		ITsys_##TYPE(TsysAlloc* _tsys, TsysBase* _element, DATA const& _data)						\
-			:TsysBase_(_tsys), element(_element), data(_data) {}									\
-		ITsys* GetElement()override { return element; }												\
+			:TsysBase_(_tsys), data(_data) { SetElement(_element); }								\
 
 #define ITSYS_MEMBERS_WITHPARAMS_WITHOUT_ELEMENT(TYPE, DATA, DATA_RET, NAME)						\
 	ITSYS_MEMBERS_WITHPARAMS_SHARED(TYPE, DATA, DATA_RET, NAME)										\
@@ -365,10 +398,16 @@ Concrete Tsys (Element Only)
 
 class ITSYS_CLASS(LRef)
 {
-	ITSYS_MEMBERS_REF(LRef)
 	ITSYS_REPLACE_GENERIC_ARGS_WITH_ELEMENT(LRefOf, )
 
 public:
+	ITsys_LRef(TsysAlloc* _tsys, TsysBase* _element)
+		:TsysBase_(_tsys)
+	{
+		SetElement(_element);
+		SetEntityOfReference(TsysRefType::LRef);
+	}
+
 	ITsys* LRefOf()override
 	{
 		return this;
@@ -383,21 +422,20 @@ public:
 	{
 		return this;
 	}
-
-protected:
-	ITsys* GetEntityInternal(TsysCV& cv, TsysRefType& refType)override
-	{
-		refType = TsysRefType::LRef;
-		return element->GetEntityInternal(cv, refType);
-	}
 };
 
 class ITSYS_CLASS(RRef)
 {
-	ITSYS_MEMBERS_REF(RRef)
 	ITSYS_REPLACE_GENERIC_ARGS_WITH_ELEMENT(RRefOf, )
 
 public:
+	ITsys_RRef(TsysAlloc* _tsys, TsysBase* _element)
+		:TsysBase_(_tsys)
+	{
+		SetElement(_element);
+		SetEntityOfReference(TsysRefType::RRef);
+	}
+
 	ITsys* LRefOf()override
 	{
 		return element->LRefOf();
@@ -412,13 +450,6 @@ public:
 	{
 		return this;
 	}
-
-protected:
-	ITsys* GetEntityInternal(TsysCV& cv, TsysRefType& refType)override
-	{
-		refType = TsysRefType::RRef;
-		return element->GetEntityInternal(cv, refType);
-	}
 };
 
 class ITSYS_CLASS(Ptr)
@@ -429,27 +460,45 @@ class ITSYS_CLASS(Ptr)
 
 class ITSYS_CLASS(Array)
 {
-	ITSYS_MEMBERS_DATA_WITHELEMENT(Array, vint, ParamCount)
 	ITSYS_REPLACE_GENERIC_ARGS_WITH_ELEMENT(ArrayOf, data)
+
+protected:
+	vint					data;
+
+public:
+	ITsys_Array(TsysAlloc* _tsys, TsysBase* _element, vint const& _data)
+		:TsysBase_(_tsys), data(_data)
+	{
+		SetElement(_element);
+	}
+
+	vint GetArrayDimensions()override
+	{
+		return data;
+	}
 };
 
 class ITSYS_CLASS(CV)
 {
-	ITSYS_MEMBERS_DATA_WITHELEMENT(CV, TsysCV, CV)
 	ITSYS_REPLACE_GENERIC_ARGS_WITH_ELEMENT(CVOf, data)
 
+protected:
+	TsysCV					data;
+
+public:
+	ITsys_CV(TsysAlloc* _tsys, TsysBase* _element, TsysCV const& _data)
+		:TsysBase_(_tsys), data(_data)
+	{
+		SetElement(_element);
+		SetEntityOfCV(data);
+	}
+
 	ITsys* CVOf(TsysCV cv)override
 	{
 		cv.isGeneralConst |= data.isGeneralConst;
 		cv.isVolatile |= data.isVolatile;
 		return element->CVOf(cv);
 	}
-protected:
-	ITsys* GetEntityInternal(TsysCV& cv, TsysRefType& refType)override
-	{
-		cv = data;
-		return element->GetEntityInternal(cv, refType);
-	}
 };
 
 class ITSYS_CLASS(Member)
@@ -486,20 +535,14 @@ Concrete Tsys (Params)
 ***********************************************************************/
 
 template<typename TType, typename TData, vint BlockSize>
-ITsys* ParamsOf(IEnumerable<ITsys*>& params, const TData& data, WithParamsList<TType, TData>& paramsOf, TsysBase* element, TsysAlloc* tsys, ITsys_Allocator<TType, BlockSize> TsysAlloc::* alloc)
+ITsys* ParamsOf(IEnumerable<ITsys*>& params, const TData& data, WithParamsTable<TType, TData>& paramsOf, TsysBase* element, TsysAlloc* tsys, ITsys_Allocator<TType, BlockSize> TsysAlloc::* alloc)
 {
-	WithParams<TType, TData> key;
-	key.params = &params;
-	key.itsys = nullptr;
-	key.data = data;
-	vint index = paramsOf.IndexOf(key);
-	if (index != -1) return paramsOf[index].itsys;
+	vuint hash = WithParamsTable<TType, TData>::Hash(params, data);
+	if (auto itsys = paramsOf.Get(hash, params, data)) return itsys;
 
 	auto itsys = (tsys->*alloc).Alloc(tsys, element, data);
-	CopyFrom(itsys->GetParams(), params);
-	key.params = &itsys->GetParams();
-	key.itsys = itsys;
-	paramsOf.Add(key);
+	itsys->SetParams(params);
+	paramsOf.Add(hash, itsys);
 	return itsys;
 }
 
@@ -682,6 +725,7 @@ public:
 		}
 
 		auto itsys = &((T*)lastNode->items)[lastNode->used++];
+		CountProfilerEvent(ProfilerCounter::TsysCreated);
 #ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
 #undef new
 #endif
@@ -704,9 +748,10 @@ protected:
 	ITsys_Nullptr											tsysNullptr;
 	ITsys_Primitive*										primitives[(vint)TsysPrimitiveType::_COUNT * (vint)TsysBytes::_COUNT] = { 0 };
 	Dictionary<Symbol*, ITsys_Decl*>						decls;
-	WithParamsList<ITsys_DeclInstant, TsysDeclInstant>		declInstantOf;
-	WithParamsList<ITsys_Init, TsysInit>					initOf;
+	WithParamsTable<ITsys_DeclInstant, TsysDeclInstant>		declInstantOf;
+	WithParamsTable<ITsys_Init, TsysInit>					initOf;
 	vint													anonymousCounter = 0;
+	TypeConvCache											typeConvCache;
 
 public:
 	ITsys_Allocator<ITsys_Primitive,			1024>		_primitive;
@@ -893,6 +938,11 @@ public:
 	{
 		return anonymousCounter++;
 	}
+
+	TypeConvCache& GetTypeConvCache()override
+	{
+		return typeConvCache;
+	}
 };
 
 Ptr<ITsysAlloc> ITsysAlloc::Create()
@@ -924,6 +974,7 @@ ITsys* TsysBase::PtrOf()
 
 ITsys* TsysBase::ArrayOf(vint dimensions)
 {
+	auto& arrayOf = GetDerivedTables().arrayOf;
 	vint index = arrayOf.Keys().IndexOf(dimensions);
 	if (index != -1) return arrayOf.Values()[index];
 	auto itsys = tsys->_array.Alloc(tsys, this, dimensions);
@@ -933,12 +984,13 @@ ITsys* TsysBase::ArrayOf(vint dimensions)
 
 ITsys* TsysBase::FunctionOf(IEnumerable<ITsys*>& params, TsysFunc func)
 {
-	return ParamsOf(params, func, functionOf, this, tsys, &TsysAlloc::_function);
+	return ParamsOf(params, func, GetDerivedTables().functionOf, this, tsys, &TsysAlloc::_function);
 }
 
 ITsys* TsysBase::MemberOf(ITsys* classType)
 {
 	if (!classType) throw L"classType should not be nullptr";
+	auto& memberOf = GetDerivedTables().memberOf;
 	vint index = memberOf.Keys().IndexOf(classType);
 	if (index != -1) return memberOf.Values()[index];
 	auto itsys = tsys->_member.Alloc(tsys, this, classType);
@@ -967,7 +1019,7 @@ ITsys* TsysBase::CVOf(TsysCV cv)
 
 ITsys* TsysBase::GenericFunctionOf(IEnumerable<ITsys*>& params, const TsysGenericFunction& genericFunction)
 {
-	return ParamsOf(params, genericFunction, genericFunctionOf, this, tsys, &TsysAlloc::_genericFunction);
+	return ParamsOf(params, genericFunction, GetDerivedTables().genericFunctionOf, this, tsys, &TsysAlloc::_genericFunction);
 }
 
 /***********************************************************************
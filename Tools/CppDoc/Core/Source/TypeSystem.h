@@ -2,6 +2,7 @@
 #define VCZH_DOCUMENT_CPPDOC_TYPESYSTEM
 
 #include <VlppRegex.h>
+#include "Profiler.h"
 
 using namespace vl;
 using namespace vl::collections;
@@ -12,6 +13,109 @@ struct ParsingArguments;
 class FunctionType;
 class TemplateSpec;
 class ITsys;
+class TypeConvCache;
+
+inline vuint HashCombine(vuint hash, vuint value)
+{
+	return hash ^ (value + (vuint)0x9E3779B9 + (hash << 6) + (hash >> 2));
+}
+
+inline vuint HashString(const WString& text)
+{
+	// FNV-1a
+	vuint hash = (vuint)2166136261U;
+	auto buffer = text.Buffer();
+	for (vint i = 0; i < text.Length(); i++)
+	{
+		hash ^= (vuint)buffer[i];
+		hash *= (vuint)16777619U;
+	}
+	return hash;
+}
+
+/***********************************************************************
+HashBuckets
+***********************************************************************/
+
+// open addressing hash table of indices to items stored by the owner, -1 for empty buckets
+// the number of buckets is always a power of 2, and all items are added again when it is more than half full
+class HashBuckets
+{
+protected:
+	Array<vint>						buckets;
+
+public:
+	vint Count()const
+	{
+		return buckets.Count();
+	}
+
+	bool IsFull(vint itemCount)const
+	{
+		return itemCount * 2 > buckets.Count();
+	}
+
+	void Resize(vint bucketCount)
+	{
+		buckets.Resize(bucketCount);
+		for (vint i = 0; i < bucketCount; i++)
+		{
+			buckets[i] = -1;
+		}
+	}
+
+	void MoveFrom(HashBuckets& from)
+	{
+		buckets.Resize(from.buckets.Count());
+		for (vint i = 0; i < buckets.Count(); i++)
+		{
+			buckets[i] = from.buckets[i];
+		}
+		from.buckets.Resize(0);
+	}
+
+	// indices of the same hash are probed in the order of adding
+	template<typename TMatch>
+	vint Find(vuint hash, TMatch&& match)const
+	{
+		if (buckets.Count() == 0) return -1;
+
+		vint mask = buckets.Count() - 1;
+		for (vint i = (vint)(hash & (vuint)mask); ; i = (i + 1) & mask)
+		{
+			vint index = buckets[i];
+			if (index == -1 || match(index)) return index;
+		}
+	}
+
+	void Add(vuint hash, vint index)
+	{
+		vint mask = buckets.Count() - 1;
+		vint i = (vint)(hash & (vuint)mask);
+		while (buckets[i] != -1)
+		{
+			i = (i + 1) & mask;
+		}
+		buckets[i] = index;
+	}
+	// adds the last one of itemCount items, all items are added again if the table is full
+	template<typename THash>
+	void AddLast(vint itemCount, vint initialBucketCount, THash&& hashOf)
+	{
+		if (IsFull(itemCount))
+		{
+			Resize(buckets.Count() == 0 ? initialBucketCount : buckets.Count() * 2);
+			for (vint i = 0; i < itemCount; i++)
+			{
+				Add(hashOf(i), i);
+			}
+		}
+		else
+		{
+			Add(hashOf(itemCount - 1), itemCount - 1);
+		}
+	}
+};
 
 /***********************************************************************
 ExprTsysType
@@ -50,6 +154,11 @@ struct ExprHeader
 		return 0;
 	}
 
+	static vuint Hash(const ExprHeader& a)
+	{
+		return HashCombine((vuint)a.symbol, (vuint)a.type);
+	}
+
 	bool operator==	(const ExprHeader& item)const { return Compare(*this, item) == 0; }
 	bool operator!=	(const ExprHeader& item)const { return Compare(*this, item) != 0; }
 	bool operator<	(const ExprHeader& item)const { return Compare(*this, item) < 0; }
@@ -90,6 +199,11 @@ struct ExprTsysItem : ExprHeader
 		return 0;
 	}
 
+	static vuint Hash(const ExprTsysItem& a)
+	{
+		return HashCombine(ExprHeader::Hash(a), (vuint)a.tsys);
+	}
+
 	bool operator==	(const ExprTsysItem& item)const { return Compare(*this, item) == 0; }
 	bool operator!=	(const ExprTsysItem& item)const { return Compare(*this, item) != 0; }
 	bool operator<	(const ExprTsysItem& item)const { return Compare(*this, item) < 0;  }
@@ -99,7 +213,84 @@ struct ExprTsysItem : ExprHeader
 };
 
 using TypeTsysList = List<ITsys*>;
-using ExprTsysList = List<ExprTsysItem>;
+
+/***********************************************************************
+ExprTsysList
+***********************************************************************/
+
+// candidate types of an expression, most of them have only a few items, but overload sets could have hundreds
+// items are stored inline until there are more than InlineCapacity of them, and then a hash table of positions is used for Contains and IndexOf
+class ExprTsysList : public Object, public virtual IEnumerable<ExprTsysItem>
+{
+protected:
+	static const vint				InlineCapacity = 4;
+
+	ExprTsysItem					inlineItems[InlineCapacity];
+	ExprTsysItem*					items = inlineItems;
+	vint							count = 0;
+	vint							capacity = InlineCapacity;
+	HashBuckets						buckets;			// positions in items, only used out of the inline storage
+
+	void							MoveFrom(ExprTsysList& list);
+	void							AddToBuckets(vint index);
+	void							RebuildBuckets(vint bucketCount);
+
+public:
+	ExprTsysList() = default;
+	ExprTsysList(const ExprTsysList&) = delete;
+	ExprTsysList(ExprTsysList&& list);
+	~ExprTsysList();
+
+	ExprTsysList&					operator=(const ExprTsysList&) = delete;
+	ExprTsysList&					operator=(ExprTsysList&& list);
+
+	IEnumerator<ExprTsysItem>*		CreateEnumerator()const override;
+
+	vint							Count()const { return count; }
+	const ExprTsysItem&				Get(vint index)const;
+	const ExprTsysItem&				operator[](vint index)const { return Get(index); }
+	bool							Contains(const ExprTsysItem& item)const { return IndexOf(item) != -1; }
+	vint							IndexOf(const ExprTsysItem& item)const;
+
+	vint							Add(const ExprTsysItem& item);
+	bool							RemoveAt(vint index);
+	bool							Clear();
+};
+
+// templates that work on both ITsys* and ExprTsysItem use TsysList<T> for the list type
+template<typename T>
+struct TsysListOf;
+
+template<>
+struct TsysListOf<ITsys*>
+{
+	using Type = TypeTsysList;
+};
+
+template<>
+struct TsysListOf<ExprTsysItem>
+{
+	using Type = ExprTsysList;
+};
+
+template<typename T>
+using TsysList = typename TsysListOf<T>::Type;
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace randomaccess_internal
+		{
+			template<>
+			struct RandomAccessable<ExprTsysList>
+			{
+				static const bool			CanRead = true;
+				static const bool			CanResize = false;
+			};
+		}
+	}
+}
 
 /***********************************************************************
 Interface
@@ -172,6 +363,11 @@ struct TsysFunc
 		if (a.ellipsis > b.ellipsis) return 1;
 		return 0;
 	}
+
+	static vuint Hash(const TsysFunc& a)
+	{
+		return HashCombine((vuint)a.callingConvention, (vuint)a.ellipsis);
+	}
 };
 
 struct TsysInit
@@ -186,6 +382,16 @@ struct TsysInit
 	{
 		return CompareEnumerable(a.headers, b.headers);
 	}
+
+	static vuint Hash(const TsysInit& a)
+	{
+		vuint hash = 0;
+		for (vint i = 0; i < a.headers.Count(); i++)
+		{
+			hash = HashCombine(hash, ExprHeader::Hash(a.headers[i]));
+		}
+		return hash;
+	}
 };
 
 struct TsysGenericFunction
@@ -226,6 +432,15 @@ struct TsysGenericFunction
 		if (a.spec > b.spec) return 1;
 		return 0;
 	}
+
+	static vuint Hash(const TsysGenericFunction& a)
+	{
+		vuint hash = (vuint)a.declSymbol;
+		hash = HashCombine(hash, (vuint)a.parentDeclType);
+		hash = HashCombine(hash, (vuint)a.filledArguments);
+		hash = HashCombine(hash, (vuint)a.spec.Obj());
+		return hash;
+	}
 };
 
 struct TsysGenericArg
@@ -265,6 +480,11 @@ struct TsysDeclInstant
 		return 0;
 	}
 
+	static vuint Hash(const TsysDeclInstant& a)
+	{
+		return HashCombine((vuint)a.declSymbol, (vuint)a.parentDeclType);
+	}
+
 	bool operator==	(const TsysDeclInstant& arg)const { return Compare(*this, arg) == 0; }
 	bool operator!=	(const TsysDeclInstant& arg)const { return Compare(*this, arg) != 0; }
 	bool operator<	(const TsysDeclInstant& arg)const { return Compare(*this, arg) < 0; }
@@ -326,7 +546,7 @@ namespace vl
 	LRef:				Element&
 	RRef:				Element&&
 	Ptr:				Element*
-	Array:				Element[]
+	Array:				Element[], ArrayDimensions is the number of dimensions
 	Function:			(Params)->Element, Func contrains other configuration
 	Member:				Element Class::
 	CV:					Element const volatile
@@ -345,14 +565,14 @@ namespace vl
 	GenericArg:			The GenericArg.argIndex-th type argument in Element
 */
 
-enum class TsysType
+enum class TsysType : vuint8_t
 {
 #define DEFINE_TSYS_TYPE(NAME) NAME,
 	TSYS_TYPE_LIST(DEFINE_TSYS_TYPE)
 #undef DEFINE_TSYS_TYPE
 };
 
-enum class TsysRefType
+enum class TsysRefType : vuint8_t
 {
 	None,
 	LRef,
@@ -361,14 +581,42 @@ enum class TsysRefType
 
 class ITsys abstract : public Interface
 {
+protected:
+	// fixed header filled when a type is created, hot queries read it directly instead of calling virtual functions
+	// cv is the data of a CV type, or the cv of the entity type for LRef and RRef
+	TsysType							type;
+	TsysRefType							entityRefType = TsysRefType::None;
+	TsysCV								cv;
+	vint32_t							paramCount = 0;
+	ITsys* const*						paramBuffer = nullptr;
+	ITsys*								element = nullptr;
+	ITsys*								entity = this;
+
+	ITsys(TsysType _type) :type(_type) {}
 public:
-	virtual TsysType					GetType() = 0;
+	TsysType							GetType()					{ return type; }
+	TsysCV								GetCV()						{ return cv; }
+	ITsys*								GetElement()				{ return element; }
+	vint								GetParamCount()				{ return paramCount; }
+
+	ITsys* GetParam(vint index)
+	{
+#ifdef _DEBUG
+		CHECK_ERROR(0 <= index && index < paramCount, L"ITsys::GetParam(vint)#Argument index not in range.");
+#endif
+		return paramBuffer[index];
+	}
+
+	ITsys* GetEntity(TsysCV& _cv, TsysRefType& _refType)
+	{
+		_cv = cv;
+		_refType = entityRefType;
+		return entity;
+	}
+
 	virtual TsysPrimitive				GetPrimitive() = 0;
-	virtual TsysCV						GetCV() = 0;
-	virtual ITsys*						GetElement() = 0;
+	virtual vint						GetArrayDimensions() = 0;
 	virtual ITsys*						GetClass() = 0;
-	virtual ITsys*						GetParam(vint index) = 0;
-	virtual vint						GetParamCount() = 0;
 	virtual TsysFunc					GetFunc() = 0;
 	virtual const TsysInit&				GetInit() = 0;
 	virtual const TsysGenericFunction&	GetGenericFunction() = 0;
@@ -386,7 +634,6 @@ public:
 	virtual ITsys*						GenericFunctionOf(IEnumerable<ITsys*>& params, const TsysGenericFunction& genericFunction) = 0;
 	virtual ITsys*						GenericArgOf(TsysGenericArg genericArg) = 0;
 
-	virtual ITsys*						GetEntity(TsysCV& cv, TsysRefType& refType) = 0;
 	virtual bool						IsUnknownType() = 0;
 	virtual bool						HasGenericArg(const ParsingArguments& pa) = 0;
 	virtual bool						HasUnknownType() = 0;
@@ -414,6 +661,7 @@ public:
 	virtual ITsys*				InitOf(Array<ExprTsysItem>& params) = 0;
 
 	virtual vint				AllocateAnonymousCounter() = 0;
+	virtual TypeConvCache&		GetTypeConvCache() = 0;
 
 	static Ptr<ITsysAlloc>		Create();
 };
@@ -458,6 +706,31 @@ struct TypeConv
 	inline static TypeConv		Max() { return { TypeConvCat::Illegal,true,false }; }
 };
 
+class TypeConvCache : public Object
+{
+protected:
+	struct Entry
+	{
+		ITsys*										toType = nullptr;
+		ITsys*										fromType = nullptr;
+		TypeConv									result;
+	};
+
+	List<Entry>										entries;
+	HashBuckets										buckets;
+	vint											hits = 0;
+	vint											misses = 0;
+
+	static vuint									Hash(ITsys* toType, ITsys* fromType);
+	vint											Find(vuint hash, ITsys* toType, ITsys* fromType);
+
+public:
+	bool						TryGet(ITsys* toType, ITsys* fromType, TypeConv& result);
+	void						Set(ITsys* toType, ITsys* fromType, TypeConv result);
+	vint						GetHitCount();
+	vint						GetMissCount();
+};
+
 extern ITsys*					ApplyExprTsysType(ITsys* tsys, ExprTsysType type);
 extern ITsys*					CvRefOf(ITsys* tsys, TsysCV cv, TsysRefType refType);
 extern ITsys*					GetThisEntity(ITsys* thisType);
@@ -1,5 +1,211 @@
 #include "Ast_Resolving.h"
 
+/***********************************************************************
+ExprTsysList
+***********************************************************************/
+
+class ExprTsysListEnumerator : public Object, public virtual IEnumerator<ExprTsysItem>
+{
+protected:
+	const ExprTsysList*				list;
+	vint							index;
+
+public:
+	ExprTsysListEnumerator(const ExprTsysList* _list, vint _index = -1)
+		:list(_list), index(_index)
+	{
+	}
+
+	IEnumerator<ExprTsysItem>* Clone()const override
+	{
+		return new ExprTsysListEnumerator(list, index);
+	}
+
+	const ExprTsysItem& Current()const override
+	{
+		return list->Get(index);
+	}
+
+	vint Index()const override
+	{
+		return index;
+	}
+
+	bool Next()override
+	{
+		index++;
+		return index >= 0 && index < list->Count();
+	}
+
+	void Reset()override
+	{
+		index = -1;
+	}
+};
+
+void ExprTsysList::MoveFrom(ExprTsysList& list)
+{
+	if (list.items == list.inlineItems)
+	{
+		for (vint i = 0; i < list.count; i++)
+		{
+			inlineItems[i] = list.inlineItems[i];
+		}
+		items = inlineItems;
+		capacity = InlineCapacity;
+	}
+	else
+	{
+		items = list.items;
+		capacity = list.capacity;
+	}
+	count = list.count;
+	buckets.MoveFrom(list.buckets);
+
+	list.items = list.inlineItems;
+	list.count = 0;
+	list.capacity = InlineCapacity;
+}
+
+void ExprTsysList::AddToBuckets(vint index)
+{
+	// only the first one of duplicated items is indexed, because IndexOf returns the first one
+	vuint hash = ExprTsysItem::Hash(items[index]);
+	vint first = buckets.Find(hash, [&](vint position)
+	{
+		return items[position] == items[index];
+	});
+
+	if (first == -1)
+	{
+		buckets.Add(hash, index);
+	}
+}
+
+void ExprTsysList::RebuildBuckets(vint bucketCount)
+{
+	buckets.Resize(bucketCount);
+	for (vint i = 0; i < count; i++)
+	{
+		AddToBuckets(i);
+	}
+}
+
+ExprTsysList::ExprTsysList(ExprTsysList&& list)
+{
+	MoveFrom(list);
+}
+
+ExprTsysList::~ExprTsysList()
+{
+	if (items != inlineItems)
+	{
+		delete[] items;
+	}
+}
+
+ExprTsysList& ExprTsysList::operator=(ExprTsysList&& list)
+{
+	if (this != &list)
+	{
+		if (items != inlineItems)
+		{
+			delete[] items;
+		}
+		MoveFrom(list);
+	}
+	return *this;
+}
+
+IEnumerator<ExprTsysItem>* ExprTsysList::CreateEnumerator()const
+{
+	return new ExprTsysListEnumerator(this);
+}
+
+const ExprTsysItem& ExprTsysList::Get(vint index)const
+{
+	CHECK_ERROR(0 <= index && index < count, L"ExprTsysList::Get(vint)#Argument index not in range.");
+	return items[index];
+}
+
+vint ExprTsysList::IndexOf(const ExprTsysItem& item)const
+{
+	if (buckets.Count() == 0)
+	{
+		for (vint i = 0; i < count; i++)
+		{
+			if (items[i] == item) return i;
+		}
+		return -1;
+	}
+
+	return buckets.Find(ExprTsysItem::Hash(item), [&](vint position)
+	{
+		return items[position] == item;
+	});
+}
+
+vint ExprTsysList::Add(const ExprTsysItem& item)
+{
+	if (count == capacity)
+	{
+		capacity *= 2;
+		auto newItems = new ExprTsysItem[capacity];
+		for (vint i = 0; i < count; i++)
+		{
+			newItems[i] = items[i];
+		}
+		if (items != inlineItems)
+		{
+			delete[] items;
+		}
+		items = newItems;
+	}
+
+	vint index = count++;
+	items[index] = item;
+
+	if (count > InlineCapacity)
+	{
+		if (buckets.IsFull(count))
+		{
+			RebuildBuckets(buckets.Count() == 0 ? InlineCapacity * 4 : buckets.Count() * 2);
+		}
+		else
+		{
+			AddToBuckets(index);
+		}
+	}
+	return index;
+}
+
+bool ExprTsysList::RemoveAt(vint index)
+{
+	CHECK_ERROR(0 <= index && index < count, L"ExprTsysList::RemoveAt(vint)#Argument index not in range.");
+	for (vint i = index + 1; i < count; i++)
+	{
+		items[i - 1] = items[i];
+	}
+	count--;
+
+	if (buckets.Count() > 0)
+	{
+		RebuildBuckets(buckets.Count());
+	}
+	return true;
+}
+
+bool ExprTsysList::Clear()
+{
+	count = 0;
+	buckets.Resize(0);
+	return true;
+}
+
+/***********************************************************************
+Helpers
+***********************************************************************/
+
 ITsys* ApplyExprTsysType(ITsys* tsys, ExprTsysType type)
 {
 	switch (type)
@@ -66,7 +66,7 @@ Utilities
 	{
 		if (tsys->GetType() == TsysType::Array)
 		{
-			vint d = tsys->GetParamCount();
+			vint d = tsys->GetArrayDimensions();
 			if (d <= 1)
 			{
 				tsys = tsys->GetElement();
@@ -1004,16 +1004,127 @@ TypeConv TestTypeConversionInternal(const ParsingArguments& pa, ITsys* toType, I
 	}
 }
 
-TCITestedSet* globalCache = nullptr;
+/***********************************************************************
+TypeConvCache
+***********************************************************************/
+
+vuint TypeConvCache::Hash(ITsys* toType, ITsys* fromType)
+{
+	return HashCombine((vuint)toType, (vuint)fromType);
+}
+
+vint TypeConvCache::Find(vuint hash, ITsys* toType, ITsys* fromType)
+{
+	return buckets.Find(hash, [&](vint i)
+	{
+		auto& entry = entries[i];
+		return entry.toType == toType && entry.fromType == fromType;
+	});
+}
+
+bool TypeConvCache::TryGet(ITsys* toType, ITsys* fromType, TypeConv& result)
+{
+	vint index = Find(Hash(toType, fromType), toType, fromType);
+	if (index != -1)
+	{
+		hits++;
+		result = entries[index].result;
+		return true;
+	}
+
+	misses++;
+	return false;
+}
+
+void TypeConvCache::Set(ITsys* toType, ITsys* fromType, TypeConv result)
+{
+	vuint hash = Hash(toType, fromType);
+	vint index = Find(hash, toType, fromType);
+	if (index != -1)
+	{
+		entries[index].result = result;
+		return;
+	}
+
+	index = entries.Add({ toType,fromType,result });
+	buckets.AddLast(entries.Count(), 64, [&](vint i)
+	{
+		return Hash(entries[i].toType, entries[i].fromType);
+	});
+}
+
+vint TypeConvCache::GetHitCount()
+{
+	return hits;
+}
+
+vint TypeConvCache::GetMissCount()
+{
+	return misses;
+}
+
+/***********************************************************************
+TestTypeConversion
+***********************************************************************/
+
+bool IsTypeConversionCacheable(ITsys* type)
+{
+	// user defined conversions and base classes of a class are not available before the class is completed
+	switch (type->GetType())
+	{
+	case TsysType::LRef:
+	case TsysType::RRef:
+	case TsysType::Ptr:
+	case TsysType::Array:
+	case TsysType::CV:
+		return IsTypeConversionCacheable(type->GetElement());
+	case TsysType::Member:
+		return IsTypeConversionCacheable(type->GetElement()) && IsTypeConversionCacheable(type->GetClass());
+	case TsysType::Function:
+		if (!IsTypeConversionCacheable(type->GetElement())) return false;
+		break;
+	case TsysType::Decl:
+	case TsysType::DeclInstant:
+		if (TryGetForwardDeclFromType<ForwardClassDeclaration>(type))
+		{
+			auto classDecl = TryGetDeclFromType<ClassDeclaration>(type);
+			if (!classDecl || !classDecl->completed) return false;
+		}
+		if (type->GetType() == TsysType::Decl) return true;
+		if (type->GetElement() && !IsTypeConversionCacheable(type->GetElement())) return false;
+		break;
+	case TsysType::Init:
+		break;
+	default:
+		return true;
+	}
+
+	for (vint i = 0; i < type->GetParamCount(); i++)
+	{
+		if (!IsTypeConversionCacheable(type->GetParam(i))) return false;
+	}
+	return true;
+}
 
 TypeConv TestTypeConversion(const ParsingArguments& pa, ITsys* toType, ExprTsysItem fromItem)
 {
-	TCITestedSet localCache;
-	return TestTypeConversionInternal(
-		pa,
-		toType,
-		ApplyExprTsysType(fromItem.tsys, fromItem.type),
-		(globalCache ? *globalCache : localCache),
-		false
-	);
+	auto fromType = ApplyExprTsysType(fromItem.tsys, fromItem.type);
+	auto& cache = pa.tsys->GetTypeConvCache();
+
+	CountProfilerEvent(ProfilerCounter::TestTypeConversion);
+	TypeConv result;
+	if (cache.TryGet(toType, fromType, result))
+	{
+		CountProfilerEvent(ProfilerCounter::TypeConvCacheHit);
+		return result;
+	}
+
+	// results in the tested set could be affected by the recursion guard, only the final result is cached
+	TCITestedSet tested;
+	result = TestTypeConversionInternal(pa, toType, fromType, tested, false);
+	if (IsTypeConversionCacheable(toType) && IsTypeConversionCacheable(fromType))
+	{
+		cache.Set(toType, fromType, result);
+	}
+	return result;
 }
\ No newline at end of file
@@ -1,112 +1,79 @@
 #include "Render.h"
 
 /***********************************************************************
-AdjustSkippingIndex
+AdjustRefIndex
 ***********************************************************************/
 
-void AdjustSkippingIndex(Ptr<CppTokenCursor>& cursor, Array<TokenSkipping>& skipping, IndexTracking& index, AdjustSkippingResult& asr)
+void AdjustRefIndex(CppTokenCursor*& cursor, const FlatIndex& flatIndex, IndexTracking& tracking)
 {
-	auto& token = cursor->token;
-
-	while (true)
+	vint row = cursor->token.rowStart;
+	vint column = cursor->token.columnStart;
+	auto endsBefore = [&](vint entry)
 	{
-		if (index.index >= skipping.Count())
-		{
-			index.inRange = false;
-			return;
-		}
+		return row > flatIndex.rowEnds[entry] || (row == flatIndex.rowEnds[entry] && column > flatIndex.columnEnds[entry]);
+	};
 
-		auto& current = skipping[index.index];
-		if (token.rowStart > current.rowUntil || (token.rowStart == current.rowUntil && token.columnStart >= current.columnUntil))
-		{
-			asr.rowSkipped += current.rowUntil - current.rowSkip - 1;
-			index.index++;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	auto& current = skipping[index.index];
-	if (token.rowStart < current.rowSkip || (token.rowStart == current.rowSkip && token.columnStart < current.columnSkip))
+	while (tracking.index < flatIndex.Count() && endsBefore(tracking.index))
 	{
-		index.inRange = false;
-		return;
+		tracking.index++;
 	}
 
-	index.inRange = true;
-	asr.rowUntil = current.rowUntil;
-	asr.columnUntil = current.columnUntil;
-}
-
-/***********************************************************************
-AdjustRefIndex
-***********************************************************************/
-
-void AdjustRefIndex(Ptr<CppTokenCursor>& cursor, const SortedList<IndexToken>& keys, IndexTracking& index, const AdjustSkippingResult& asr)
-{
-	vint row = cursor->token.rowStart;
-	vint column = cursor->token.columnStart;
-	if (row == asr.rowUntil)
+	// entries are sorted by their start positions, so only a few entries after tracking.index may cover the token
+	tracking.declEntry = -1;
+	for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
 	{
-		column -= asr.columnUntil;
+		tracking.refEntries[reason] = -1;
 	}
-	row -= asr.rowSkipped;
 
-	while (true)
+	for (vint entry = tracking.index; entry < flatIndex.Count(); entry++)
 	{
-		if (index.index >= keys.Count())
-		{
-			index.inRange = false;
-			return;
-		}
+		if (row < flatIndex.rowStarts[entry] || (row == flatIndex.rowStarts[entry] && column < flatIndex.columnStarts[entry])) break;
+		if (endsBefore(entry)) continue;
 
-		auto& current = keys[index.index];
-		if (row > current.rowEnd || (row == current.rowEnd && column > current.columnEnd))
+		if (tracking.declEntry == -1 && flatIndex.decls[entry])
 		{
-			index.index++;
+			tracking.declEntry = entry;
 		}
-		else
+		for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
 		{
-			break;
+			if (tracking.refEntries[reason] == -1 && flatIndex.symbolCounts[reason][entry] > 0)
+			{
+				tracking.refEntries[reason] = entry;
+			}
 		}
 	}
-
-	auto& current = keys[index.index];
-	if (row < current.rowStart || (row == current.rowStart && column < current.columnStart))
-	{
-		index.inRange = false;
-		return;
-	}
-
-	index.inRange = true;
 }
 
 /***********************************************************************
-Submit
+AddSpan
 ***********************************************************************/
 
-WString Submit(Ptr<StreamHolder>& holder)
+void AddSpan(List<HtmlSpan>& spans, HtmlSpanKind kind)
 {
-	if (!holder) return WString::Empty;
-	holder->memoryStream.SeekFromBegin(0);
-	auto result = StreamReader(holder->memoryStream).ReadToEnd();
-	holder = nullptr;
-	return result;
+	HtmlSpan span;
+	span.kind = kind;
+	spans.Add(span);
 }
 
-/***********************************************************************
-Use
-***********************************************************************/
-
-StreamWriter& Use(Ptr<StreamHolder>& holder)
+void AddTextSpan(List<HtmlSpan>& spans, const wchar_t* divClass, const wchar_t* begin, const wchar_t* end)
 {
-	if (!holder)
+	// '\r' is not rendered, so text containing only '\r' generates nothing
+	if (!divClass)
 	{
-		holder = new StreamHolder;
+		auto reading = begin;
+		while (reading < end && *reading == L'\r')
+		{
+			reading++;
+		}
+		if (reading == end) return;
 	}
-	return holder->streamWriter;
+
+	HtmlSpan span;
+	span.kind = HtmlSpanKind::Text;
+	span.divClass = divClass;
+	span.reading = begin;
+	span.length = (vint)(end - begin);
+	spans.Add(span);
 }
 
 /***********************************************************************
@@ -115,11 +82,11 @@ GenerateHtmlToken
 
 template<typename T>
 void GenerateHtmlToken(
-	Ptr<CppTokenCursor>& cursor,
+	CppTokenCursor*& cursor,
 	Symbol* symbolForToken,
 	const wchar_t*& rawBegin,
 	const wchar_t*& rawEnd,
-	Ptr<StreamHolder>& html,
+	List<HtmlSpan>& spans,
 	vint& lineCounter,
 	const T& callback
 )
@@ -155,70 +122,51 @@ void GenerateHtmlToken(
 		}
 	}
 
-	if (divClass)
-	{
-		Use(html).WriteString(L"<div class=\"token ");
-		Use(html).WriteString(divClass);
-		Use(html).WriteString(L"\">");
-	}
-
 	auto reading = cursor->token.reading;
 	auto length = cursor->token.length;
 	bool canLineBreak = !symbolForToken && !divClass && (CppTokens)cursor->token.token == CppTokens::SPACE;
+	if (!canLineBreak)
+	{
+		for (vint i = 0; i < length; i++)
+		{
+			if (reading[i] == L'\n')
+			{
+				lineCounter++;
+			}
+		}
+		AddTextSpan(spans, divClass, reading, reading + length);
+		return;
+	}
+
+	auto textBegin = reading;
 	for (vint i = 0; i < length; i++)
 	{
 		switch (reading[i])
 		{
 		case L'\r':
-			if (canLineBreak)
-			{
-				rawEnd = &reading[i];
-			}
+			rawEnd = &reading[i];
 			break;
 		case L'\n':
-			lineCounter++;
-			if (canLineBreak)
 			{
+				lineCounter++;
 				// the last token is always a space, so it is not necessary to submit a line after all cursor is read
 				if (rawEnd != &reading[i - 1])
 				{
 					rawEnd = &reading[i];
 				}
-				callback({ lineCounter, rawBegin, rawEnd, Submit(html) });
+				AddTextSpan(spans, nullptr, textBegin, &reading[i]);
+				callback({ lineCounter, rawBegin, rawEnd }, spans);
+				spans.Clear();
 
 				lineCounter = 0;
 				rawBegin = &reading[i + 1];
 				rawEnd = rawBegin;
+				textBegin = rawBegin;
 			}
-			else
-			{
-				Use(html).WriteLine(L"");
-			}
-			break;
-		case L'<':
-			Use(html).WriteString(L"&lt;");
-			break;
-		case L'>':
-			Use(html).WriteString(L"&gt;");
 			break;
-		case L'&':
-			Use(html).WriteString(L"&amp;");
-			break;
-		case L'\'':
-			Use(html).WriteString(L"&apos;");
-			break;
-		case L'\"':
-			Use(html).WriteString(L"&quot;");
-			break;
-		default:
-			Use(html).WriteChar(reading[i]);
 		}
 	}
-
-	if (divClass)
-	{
-		Use(html).WriteString(L"</div>");
-	}
+	AddTextSpan(spans, nullptr, textBegin, reading + length);
 }
 
 /***********************************************************************
@@ -227,10 +175,9 @@ GenerateHtmlLine
 
 template<typename TCallback>
 void GenerateHtmlLine(
-	Ptr<CppTokenCursor>& cursor,
+	CppTokenCursor*& cursor,
 	Ptr<GlobalLinesRecord> global,
 	FilePath currentFilePath,
-	Array<TokenSkipping>& skipping,
 	IndexResult& result,
 	TokenTracker& tracker,
 	TCallback&& callback)
@@ -238,48 +185,31 @@ void GenerateHtmlLine(
 	if (!cursor) return;
 	const wchar_t* rawBegin = cursor->token.reading;
 	const wchar_t * rawEnd = rawBegin;
-	Ptr<StreamHolder> html;
+	List<HtmlSpan> spans;
 	vint lineCounter = 0;
 
 	bool firstToken = true;
 	while (cursor)
 	{
 		// calculate the surrounding context of the current token
-		AdjustSkippingIndex(cursor, skipping, tracker.indexSkipping, tracker.asr);
-		if (tracker.indexSkipping.inRange)
-		{
-			tracker.indexDecl.inRange = false;
-			for (vint i = 0; i < (vint)IndexReason::Max; i++)
-			{
-				tracker.indexResolve[i].inRange = false;
-			}
-		}
-		else
-		{
-			AdjustRefIndex(cursor, result.decls.Keys(), tracker.indexDecl, tracker.asr);
-			for (vint i = 0; i < (vint)IndexReason::Max; i++)
-			{
-				AdjustRefIndex(cursor, result.index[i].Keys(), tracker.indexResolve[i], tracker.asr);
-			}
-		}
+		// tokens are compiled with their positions in the preprocessed file, so they are compared with indexed tokens directly
+		auto& flatIndex = result.flatIndex;
+		auto& tracking = tracker.tracking;
+		AdjustRefIndex(cursor, flatIndex, tracking);
 
 		// a link is not possible to be the last token of a valid C++ file, so this should just work
 		auto flr = global->fileLines[currentFilePath];
-		bool isDefToken = tracker.indexDecl.inRange;
-		bool isRefToken = tracker.indexResolve[(vint)IndexReason::Resolved].inRange || tracker.indexResolve[(vint)IndexReason::OverloadedResolution].inRange;
+		bool isDefToken = tracking.declEntry != -1;
+		bool isRefToken = tracking.refEntries[(vint)IndexReason::Resolved] != -1 || tracking.refEntries[(vint)IndexReason::OverloadedResolution] != -1;
 
 		if (isDefToken && !tracker.lastTokenIsDef)
 		{
-			auto decl = result.decls.Values()[tracker.indexDecl.index];
+			Ptr<Declaration> decl = flatIndex.decls[tracking.declEntry];
 			if (!global->declToFiles.Keys().Contains(decl.Obj()))
 			{
 				global->declToFiles.Add(decl, currentFilePath);
 			}
 
-			Use(html).WriteString(L"<div class=\"def\" id=\"");
-			Use(html).WriteString(GetDeclId(decl));
-			Use(html).WriteString(L"\">");
-
 			bool generateLink = false;
 			switch (decl->symbol->GetCategory())
 			{
@@ -320,18 +250,17 @@ void GenerateHtmlLine(
 						break;
 					}
 				}
-				Use(html).WriteString(L"<div class=\"ref\" onclick=\"jumpToSymbol([], [\'");
-				Use(html).WriteString(GetSymbolId(decl->symbol));
-				Use(html).WriteString(L"\'])\">");
-			}
-			else
-			{
-				Use(html).WriteString(L"<div>");
 			}
+
+			HtmlSpan span;
+			span.kind = HtmlSpanKind::BeginDef;
+			span.decl = decl.Obj();
+			span.generateLink = generateLink;
+			spans.Add(span);
 		}
 		else if (!isDefToken && tracker.lastTokenIsDef)
 		{
-			Use(html).WriteString(L"</div></div>");
+			AddSpan(spans, HtmlSpanKind::EndDef);
 		}
 
 		// sometimes the compiler will try to parse an expression and see if it fails.
@@ -341,12 +270,12 @@ void GenerateHtmlLine(
 		{
 			for (vint i = (vint)IndexReason::OverloadedResolution; i >= (vint)IndexReason::Resolved; i--)
 			{
-				if (tracker.indexResolve[i].inRange)
+				vint entry = tracking.refEntries[i];
+				if (entry != -1)
 				{
-					auto& symbols = result.index[i].GetByIndex(tracker.indexResolve[i].index);
-					for (vint j = 0; j < symbols.Count(); j++)
+					for (vint j = 0; j < flatIndex.symbolCounts[i][entry]; j++)
 					{
-						auto symbol = symbols[j];
+						auto symbol = flatIndex.symbols[flatIndex.symbolBegins[i][entry] + j];
 						if (!flr->refSymbols.Contains(symbol))
 						{
 							flr->refSymbols.Add(symbol);
@@ -355,32 +284,17 @@ void GenerateHtmlLine(
 				}
 			}
 
-			Use(html).WriteString(L"<div class=\"ref\" onclick=\"jumpToSymbol(");
+			HtmlSpan span;
+			span.kind = HtmlSpanKind::BeginRef;
 			for (vint i = (vint)IndexReason::OverloadedResolution; i >= (vint)IndexReason::Resolved; i--)
 			{
-				if (i != (vint)IndexReason::OverloadedResolution)
-				{
-					Use(html).WriteString(L", ");
-				}
-				Use(html).WriteString(L"[");
-				if (tracker.indexResolve[i].inRange)
-				{
-					auto& symbols = result.index[i].GetByIndex(tracker.indexResolve[i].index);
-					for (vint j = 0; j < symbols.Count(); j++)
-					{
-						if (j != 0) Use(html).WriteString(L", ");
-						Use(html).WriteString(L"\'");
-						Use(html).WriteString(GetSymbolId(symbols[j]));
-						Use(html).WriteString(L"\'");
-					}
-				}
-				Use(html).WriteString(L"]");
+				span.refEntries[i] = tracking.refEntries[i];
 			}
-			Use(html).WriteString(L")\">");
+			spans.Add(span);
 		}
 		else if (!tracker.lastTokenIsDef && !isRefToken && tracker.lastTokenIsRef)
 		{
-			Use(html).WriteString(L"</div>");
+			AddSpan(spans, HtmlSpanKind::EndRef);
 		}
 
 		tracker.lastTokenIsDef = isDefToken;
@@ -396,20 +310,21 @@ void GenerateHtmlLine(
 		Symbol* symbolForToken = nullptr;
 		if (isDefToken)
 		{
-			symbolForToken = result.decls.Values()[tracker.indexDecl.index]->symbol;
+			symbolForToken = flatIndex.decls[tracking.declEntry]->symbol;
 		}
 		else if (isRefToken)
 		{
 			for (vint i = (vint)IndexReason::OverloadedResolution; i >= (vint)IndexReason::Resolved; i--)
 			{
-				if (tracker.indexResolve[i].inRange)
+				vint entry = tracking.refEntries[i];
+				if (entry != -1)
 				{
-					symbolForToken = result.index[i].GetByIndex(tracker.indexResolve[i].index)[0];
+					symbolForToken = flatIndex.symbols[flatIndex.symbolBegins[i][entry]];
 					break;
 				}
 			}
 		}
-		GenerateHtmlToken(cursor, symbolForToken, rawBegin, rawEnd, html, lineCounter, callback);
+		GenerateHtmlToken(cursor, symbolForToken, rawBegin, rawEnd, spans, lineCounter, callback);
 		SkipToken(cursor);
 		firstToken = false;
 	}
@@ -419,14 +334,12 @@ void GenerateHtmlLine(
 Collect
 ***********************************************************************/
 
-Ptr<GlobalLinesRecord> Collect(Ptr<RegexLexer> lexer, FilePath pathPreprocessed, FilePath pathInput, FilePath pathMapping, IndexResult& result)
+Ptr<GlobalLinesRecord> Collect(Ptr<CppLexer> lexer, const WString& preprocessed, IndexResult& result)
 {
 	auto global = MakePtr<GlobalLinesRecord>();
 	Dictionary<WString, FilePath> filePathCache;
-	Array<TokenSkipping> skipping;
-	ReadMappingFile(pathMapping, skipping);
 
-	global->preprocessed = File(pathPreprocessed).ReadAllTextByBom();
+	global->preprocessed = preprocessed;
 	if (global->preprocessed.Right(1) != L"\n")
 	{
 		global->preprocessed += L"\r\n";
@@ -510,11 +423,11 @@ Ptr<GlobalLinesRecord> Collect(Ptr<RegexLexer> lexer, FilePath pathPreprocessed,
 		GIVE_UP:
 			cursor = oldCursor;
 		}
-		GenerateHtmlLine(cursor, global, currentFilePath, skipping, result, tracker, [&](HtmlLineRecord hlr)
+		GenerateHtmlLine(cursor, global, currentFilePath, result, tracker, [&](HtmlLineRecord hlr, List<HtmlSpan>& spans)
 		{
 			if (rightAfterSharpLine)
 			{
-				if (hlr.htmlCode.Length() != 0)
+				if (spans.Count() != 0)
 				{
 					throw Exception(L"An empty line should have been submitted right after #line.");
 				}
@@ -523,6 +436,9 @@ Ptr<GlobalLinesRecord> Collect(Ptr<RegexLexer> lexer, FilePath pathPreprocessed,
 			else
 			{
 				auto flr = global->fileLines[currentFilePath];
+				hlr.spanBegin = flr->spans.Count();
+				hlr.spanCount = spans.Count();
+				CopyFrom(flr->spans, spans, true);
 				flr->lines.Add(currentLineNumber, hlr);
 				currentLineNumber += hlr.lineCount;
 			}
@@ -4,16 +4,20 @@
 Compile
 ***********************************************************************/
 
-void Compile(Ptr<RegexLexer> lexer, FilePath pathInput, IndexResult& result)
+void Compile(Ptr<CppTokenReader> reader, IndexResult& result, Profiler& profiler)
 {
-	WString input = File(pathInput).ReadAllTextByBom();
-	CppTokenReader reader(lexer, input);
-	auto cursor = reader.GetFirstToken();
+	auto cursor = reader->GetFirstToken();
 
+	profiler.BeginPhase(L"ParseProgram");
 	result.pa = { new Symbol(symbol_component::SymbolCategory::Normal), ITsysAlloc::Create(), new IndexRecorder(result) };
 	auto program = ParseProgram(result.pa, cursor);
+
+	profiler.BeginPhase(L"EvaluateProgram");
 	EvaluateProgram(result.pa, program);
 
+	// GenerateUniqueId enumerates and sorts children of all symbols on this thread
+	// after that the symbol tree is read-only, and pages could enumerate children in parallel
+	profiler.BeginPhase(L"IndexDeclarations");
 	result.pa.root->GenerateUniqueId(result.ids, L"");
 	for (vint i = 0; i < result.ids.Count(); i++)
 	{
@@ -61,4 +65,33 @@ void Compile(Ptr<RegexLexer> lexer, FilePath pathInput, IndexResult& result)
 			break;
 		}
 	}
+
+	result.flatIndex.Build(result);
+
+	// report templates that are looked up the most in their instantiation caches
+	List<Symbol*> genericSymbols;
+	CopyFrom(
+		genericSymbols,
+		From(result.ids.Values())
+			.Where([](Symbol* symbol)
+			{
+				return symbol->genericCache.Count() > 0;
+			})
+			.OrderBy([](Symbol* a, Symbol* b)
+			{
+				vint lookupsA = a->genericCache.GetHits() + a->genericCache.GetMisses();
+				vint lookupsB = b->genericCache.GetHits() + b->genericCache.GetMisses();
+				return lookupsA != lookupsB ? lookupsB - lookupsA : WString::Compare(a->uniqueId, b->uniqueId);
+			})
+			.Take(20)
+		);
+	FOREACH(Symbol*, symbol, genericSymbols)
+	{
+		ProfilerGenericCache genericCache;
+		genericCache.symbol = symbol->uniqueId;
+		genericCache.instantiations = symbol->genericCache.Count();
+		genericCache.hits = symbol->genericCache.GetHits();
+		genericCache.misses = symbol->genericCache.GetMisses();
+		profiler.AddGenericCache(genericCache);
+	}
 }
\ No newline at end of file
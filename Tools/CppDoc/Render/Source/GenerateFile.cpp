@@ -1,15 +1,14 @@
 #include "Render.h"
 
-extern void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer);
-extern void GenerateReferencedSymbols(Ptr<FileLinesRecord> flr, StreamWriter& writer);
-extern void GenerateSymbolToFiles(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, StreamWriter& writer);
+extern void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, Ptr<SourceFile> sourceFile, IndexResult& result, StreamWriter& writer);
 
 /***********************************************************************
 GenerateFile
 ***********************************************************************/
 
-void GenerateFile(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, IndexResult& result, FilePath pathHtml)
+void GenerateFile(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, IndexResult& result, SourceFileCache& sourceFiles, FilePath pathHtml)
 {
+	// PageFormatVersion should be increased when the markup written here changes
 	FileStream fileStream(pathHtml.GetFullPath(), FileStream::WriteOnly);
 	Utf8Encoder encoder;
 	EncoderStream encoderStream(fileStream, encoder);
@@ -32,12 +31,13 @@ void GenerateFile(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, Index
 	writer.WriteLine(L"<br>");
 
 	writer.WriteString(L"<div class=\"codebox\"><div class=\"cpp_default\">");
-	GenerateCppCodeInHtml(flr, writer);
+	GenerateCppCodeInHtml(flr, sourceFiles.Get(flr->filePath), result, writer);
 	writer.WriteLine(L"</div></div>");
 
 	writer.WriteLine(L"<script type=\"text/javascript\">");
-	GenerateReferencedSymbols(flr, writer);
-	GenerateSymbolToFiles(global, flr, writer);
+	writer.WriteString(L"currentHtmlFileName = \'");
+	writer.WriteString(flr->htmlFileName);
+	writer.WriteLine(L"\';");
 	writer.WriteLine(L"turnOnSymbol();");
 
 	writer.WriteLine(L"</script>");
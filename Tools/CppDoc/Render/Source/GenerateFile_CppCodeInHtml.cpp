@@ -1,13 +1,122 @@
 #include "Render.h"
 
+/***********************************************************************
+WriteHtmlLine
+***********************************************************************/
+
+void WriteHtmlLine(Ptr<FileLinesRecord> flr, const HtmlLineRecord& hlr, IndexResult& result, TextWriter& writer)
+{
+	for (vint spanIndex = 0; spanIndex < hlr.spanCount; spanIndex++)
+	{
+		auto& span = flr->spans[hlr.spanBegin + spanIndex];
+		switch (span.kind)
+		{
+		case HtmlSpanKind::Text:
+			{
+				if (span.divClass)
+				{
+					writer.WriteString(L"<div class=\"token ");
+					writer.WriteString(span.divClass);
+					writer.WriteString(L"\">");
+				}
+
+				for (vint i = 0; i < span.length; i++)
+				{
+					switch (span.reading[i])
+					{
+					case L'\r':
+						break;
+					case L'\n':
+						writer.WriteLine(L"");
+						break;
+					case L'<':
+						writer.WriteString(L"&lt;");
+						break;
+					case L'>':
+						writer.WriteString(L"&gt;");
+						break;
+					case L'&':
+						writer.WriteString(L"&amp;");
+						break;
+					case L'\'':
+						writer.WriteString(L"&apos;");
+						break;
+					case L'\"':
+						writer.WriteString(L"&quot;");
+						break;
+					default:
+						writer.WriteChar(span.reading[i]);
+					}
+				}
+
+				if (span.divClass)
+				{
+					writer.WriteString(L"</div>");
+				}
+			}
+			break;
+		case HtmlSpanKind::BeginDef:
+			{
+				writer.WriteString(L"<div class=\"def\" id=\"");
+				writer.WriteString(GetDeclId(Ptr<Declaration>(span.decl)));
+				writer.WriteString(L"\">");
+
+				if (span.generateLink)
+				{
+					writer.WriteString(L"<div class=\"ref\" onclick=\"jumpToSymbol([], [\'");
+					writer.WriteString(GetSymbolId(span.decl->symbol));
+					writer.WriteString(L"\'])\">");
+				}
+				else
+				{
+					writer.WriteString(L"<div>");
+				}
+			}
+			break;
+		case HtmlSpanKind::EndDef:
+			writer.WriteString(L"</div></div>");
+			break;
+		case HtmlSpanKind::BeginRef:
+			{
+				writer.WriteString(L"<div class=\"ref\" onclick=\"jumpToSymbol(");
+				for (vint i = (vint)IndexReason::OverloadedResolution; i >= (vint)IndexReason::Resolved; i--)
+				{
+					if (i != (vint)IndexReason::OverloadedResolution)
+					{
+						writer.WriteString(L", ");
+					}
+					writer.WriteString(L"[");
+					vint entry = span.refEntries[i];
+					if (entry != -1)
+					{
+						auto& flatIndex = result.flatIndex;
+						for (vint j = 0; j < flatIndex.symbolCounts[i][entry]; j++)
+						{
+							if (j != 0) writer.WriteString(L", ");
+							writer.WriteString(L"\'");
+							writer.WriteString(GetSymbolId(flatIndex.symbols[flatIndex.symbolBegins[i][entry] + j]));
+							writer.WriteString(L"\'");
+						}
+					}
+					writer.WriteString(L"]");
+				}
+				writer.WriteString(L")\">");
+			}
+			break;
+		case HtmlSpanKind::EndRef:
+			writer.WriteString(L"</div>");
+			break;
+		}
+	}
+}
+
 /***********************************************************************
 GenerateCppCodeInHtml
 ***********************************************************************/
 
-void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
+void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, Ptr<SourceFile> sourceFile, IndexResult& result, StreamWriter& writer)
 {
-	List<WString> originalLines;
-	File(flr->filePath).ReadAllLinesByBom(originalLines);
+	auto& originalLines = sourceFile->lines;
 
 	vint originalIndex = 0;
 	vint flrIndex = 0;
@@ -15,7 +124,7 @@ void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
 	{
 		vint disableEnd = -1;
 		vint nextProcessingLine = -1;
-		WString embedHtmlInDisabled;
+		const HtmlLineRecord* embedHtmlInDisabled = nullptr;
 
 		if (flrIndex == flr->lines.Count())
 		{
@@ -45,10 +154,13 @@ void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
 				bool rawCodeMatched = (nextProcessingLine - originalIndex) >= currentHtmlLines.lineCount;
 				if (rawCodeMatched)
 				{
-					StringReader reader(WString(currentHtmlLines.rawBegin, (vint)(currentHtmlLines.rawEnd - currentHtmlLines.rawBegin)));
+					// lines missing in the raw code are empty
+					auto reading = currentHtmlLines.rawBegin;
 					for (vint i = 0; i < currentHtmlLines.lineCount; i++)
 					{
-						if (originalLines[originalIndex + i] != reader.ReadLine())
+						SourceLine rawLine;
+						SourceLine::Read(reading, currentHtmlLines.rawEnd, rawLine);
+						if (originalLines[originalIndex + i] != rawLine)
 						{
 							rawCodeMatched = false;
 							break;
@@ -58,7 +170,8 @@ void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
 
 				if (rawCodeMatched)
 				{
-					writer.WriteLine(currentHtmlLines.htmlCode);
+					WriteHtmlLine(flr, currentHtmlLines, result, writer);
+					writer.WriteLine(L"");
 					nextProcessingLine = originalIndex + currentHtmlLines.lineCount;
 				}
 				else
@@ -82,7 +195,7 @@ void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
 
 					if (!allSpaces)
 					{
-						embedHtmlInDisabled = currentHtmlLines.htmlCode;
+						embedHtmlInDisabled = &currentHtmlLines;
 					}
 					disableEnd = nextProcessingLine;
 				}
@@ -95,7 +208,7 @@ void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
 
 		if (disableEnd != -1)
 		{
-			bool hasEmbeddedHtml = embedHtmlInDisabled.Length() != 0;
+			bool hasEmbeddedHtml = embedHtmlInDisabled && embedHtmlInDisabled->spanCount != 0;
 			if (hasEmbeddedHtml)
 			{
 				writer.WriteString(L"<div class=\"expandable\">");
@@ -107,13 +220,13 @@ void GenerateCppCodeInHtml(Ptr<FileLinesRecord> flr, StreamWriter& writer)
 				{
 					writer.WriteLine(L"");
 				}
-				WriteHtmlTextSingleLine(originalLines[i], writer);
+				WriteHtmlTextSingleLine(originalLines[i].begin, originalLines[i].length, writer);
 			}
 			writer.WriteLine(L"</div>");
 			if (hasEmbeddedHtml)
 			{
 				writer.WriteString(L"<div class=\"expanded\">");
-				writer.WriteString(embedHtmlInDisabled);
+				WriteHtmlLine(flr, *embedHtmlInDisabled, result, writer);
 				writer.WriteLine(L"</div></div>");
 			}
 		}
@@ -0,0 +1,225 @@
+#include "Render.h"
+
+/***********************************************************************
+GetSymbolShardIndex
+***********************************************************************/
+
+vint GetSymbolShardIndex(const WString& symbolId, vint shardCount)
+{
+	// FNV-1a over UTF-16 code units, it must be the same as getSymbolShardIndex in Cpp.js
+	vuint32_t hash = 2166136261U;
+	for (vint i = 0; i < symbolId.Length(); i++)
+	{
+		hash ^= (vuint32_t)(vuint16_t)symbolId[i];
+		hash *= 16777619U;
+	}
+	return (vint)(hash & (vuint32_t)(shardCount - 1));
+}
+
+/***********************************************************************
+WriteDeclFiles
+***********************************************************************/
+
+void WriteDeclFiles(Ptr<GlobalLinesRecord> global, const wchar_t* name, List<Ptr<Declaration>>& decls, bool lastField, StreamWriter& writer)
+{
+	writer.WriteString(L"        \'");
+	writer.WriteString(name);
+	if (decls.Count() == 0)
+	{
+		writer.WriteLine(lastField ? L"\': []" : L"\': [],");
+		return;
+	}
+
+	writer.WriteLine(L"\': [");
+	for (vint i = 0; i < decls.Count(); i++)
+	{
+		auto decl = decls[i];
+		writer.WriteString(L"            { \'elementId\': \'");
+		writer.WriteString(GetDeclId(decl));
+		writer.WriteString(L"\', \'file\': ");
+
+		// a declaration that is not rendered in any page has no file
+		vint index = global->declToFiles.Keys().IndexOf(decl.Obj());
+		if (index == -1)
+		{
+			writer.WriteString(L"null");
+		}
+		else
+		{
+			auto flrTarget = global->fileLines[global->declToFiles.Values()[index]];
+			writer.WriteString(L"{ \'htmlFileName\': \'");
+			writer.WriteString(flrTarget->htmlFileName);
+			writer.WriteString(L"\', \'displayName\': \'");
+			writer.WriteString(flrTarget->filePath.GetName());
+			writer.WriteString(L"\' }");
+		}
+		writer.WriteLine(i == decls.Count() - 1 ? L" }" : L" },");
+	}
+	writer.WriteLine(lastField ? L"        ]" : L"        ],");
+}
+
+/***********************************************************************
+WriteSymbolShard
+***********************************************************************/
+
+void WriteSymbolShard(Ptr<GlobalLinesRecord> global, vint shardIndex, Dictionary<WString, Symbol*>& symbols, StreamWriter& writer)
+{
+	writer.WriteString(L"registerSymbolShard(");
+	writer.WriteString(itow(shardIndex));
+	writer.WriteLine(L", {");
+	for (vint i = 0; i < symbols.Count(); i++)
+	{
+		auto symbol = symbols.Values()[i];
+		writer.WriteString(L"    \'");
+		writer.WriteString(symbols.Keys()[i]);
+		writer.WriteLine(L"\': {");
+
+		writer.WriteString(L"        \'displayNameInHtml\': \'");
+		writer.WriteString(GetSymbolDisplayNameInHtml(symbol));
+		writer.WriteLine(L"\',");
+
+		List<Ptr<Declaration>> impls, decls;
+		EnumerateDecls(symbol, [&](Ptr<Declaration> decl, bool isImpl, vint index)
+		{
+			(isImpl ? impls : decls).Add(decl);
+		});
+		WriteDeclFiles(global, L"impls", impls, false, writer);
+		WriteDeclFiles(global, L"decls", decls, true, writer);
+
+		writer.WriteLine(i == symbols.Count() - 1 ? L"    }" : L"    },");
+	}
+	writer.WriteLine(L"});");
+}
+
+/***********************************************************************
+ReadShardManifest
+***********************************************************************/
+
+void ReadShardManifest(File fileManifest, SortedList<WString>& shardFileNames)
+{
+	if (!fileManifest.Exists()) return;
+
+	// each shard is in its own line: '{shardName}',
+	List<WString> lines;
+	fileManifest.ReadAllLinesByBom(lines);
+	FOREACH(WString, line, lines)
+	{
+		if (line.Length() > 5 && line.Left(5) == L"    \'")
+		{
+			auto shardName = line.Sub(5, line.Length() - 5);
+			vint index = shardName.IndexOf(L'\'');
+			if (index == -1) continue;
+
+			auto shardFileName = shardName.Left(index) + L".js";
+			if (!shardFileNames.Contains(shardFileName))
+			{
+				shardFileNames.Add(shardFileName);
+			}
+		}
+	}
+}
+
+/***********************************************************************
+GenerateSymbolDatabase
+***********************************************************************/
+
+void GenerateSymbolDatabase(Ptr<GlobalLinesRecord> global, Folder folderSymbols)
+{
+	if (!folderSymbols.Exists())
+	{
+		folderSymbols.Create(true);
+	}
+
+	// every symbol referenced by any page is written once
+	SortedList<Symbol*> refSymbols;
+	for (vint i = 0; i < global->fileLines.Count(); i++)
+	{
+		auto flr = global->fileLines.Values()[i];
+		for (vint j = 0; j < flr->refSymbols.Count(); j++)
+		{
+			auto symbol = flr->refSymbols[j];
+			if (!refSymbols.Contains(symbol))
+			{
+				refSymbols.Add(symbol);
+			}
+		}
+	}
+
+	// about 256 symbols per shard, the shard count is a power of 2
+	vint shardCount = 1;
+	while (shardCount < 4096 && shardCount * 256 < refSymbols.Count())
+	{
+		shardCount *= 2;
+	}
+
+	Array<Dictionary<WString, Symbol*>> shards(shardCount);
+	for (vint i = 0; i < refSymbols.Count(); i++)
+	{
+		auto symbol = refSymbols[i];
+		auto symbolId = GetSymbolId(symbol);
+		auto& shard = shards[GetSymbolShardIndex(symbolId, shardCount)];
+		if (!shard.Keys().Contains(symbolId))
+		{
+			shard.Add(symbolId, symbol);
+		}
+	}
+
+	// shards from the previous Shards.js are kept for one more run
+	// a page that loaded the previous Shards.js before this run could still load shards listed in it
+	File fileManifest(folderSymbols.GetFilePath() / L"Shards.js");
+	SortedList<WString> shardFileNames;
+	ReadShardManifest(fileManifest, shardFileNames);
+
+	// shards are named by the hash of their content, so that browsers could cache them across pages and runs
+	List<WString> shardNames;
+	for (vint i = 0; i < shardCount; i++)
+	{
+		StreamHolder holder;
+		WriteSymbolShard(global, i, shards[i], holder.streamWriter);
+		auto hash = HashBytes(14695981039346656037ULL, holder.memoryStream.GetInternalBuffer(), (vint)holder.memoryStream.Size());
+		auto shardName = L"Shard" + itow(i) + L"." + u64tow(hash);
+		shardNames.Add(shardName);
+		if (!shardFileNames.Contains(shardName + L".js"))
+		{
+			shardFileNames.Add(shardName + L".js");
+		}
+
+		File fileShard(folderSymbols.GetFilePath() / (shardName + L".js"));
+		if (!fileShard.Exists())
+		{
+			holder.memoryStream.SeekFromBegin(0);
+			auto content = StreamReader(holder.memoryStream).ReadToEnd();
+			fileShard.WriteAllText(content, false, BomEncoder::Utf8);
+		}
+	}
+
+	{
+		FileStream fileStream(fileManifest.GetFilePath().GetFullPath(), FileStream::WriteOnly);
+		Utf8Encoder encoder;
+		EncoderStream encoderStream(fileStream, encoder);
+		StreamWriter writer(encoderStream);
+
+		writer.WriteString(L"symbolShards = { \'count\': ");
+		writer.WriteString(itow(shardCount));
+		writer.WriteLine(L", \'files\': [");
+		for (vint i = 0; i < shardNames.Count(); i++)
+		{
+			writer.WriteString(L"    \'");
+			writer.WriteString(shardNames[i]);
+			writer.WriteLine(i == shardNames.Count() - 1 ? L"\'" : L"\',");
+		}
+		writer.WriteLine(L"] };");
+	}
+
+	// remove shards that are listed in neither the current nor the previous Shards.js
+	List<File> files;
+	folderSymbols.GetFiles(files);
+	FOREACH(File, file, files)
+	{
+		auto fileName = file.GetFilePath().GetName();
+		if (fileName != L"Shards.js" && !shardFileNames.Contains(fileName))
+		{
+			file.Delete();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "Render.h"
+
+/***********************************************************************
+HashBytes
+***********************************************************************/
+
+vuint64_t HashBytes(vuint64_t hash, const void* buffer, vint size)
+{
+	// FNV-1a
+	auto bytes = (const vuint8_t*)buffer;
+	for (vint i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+vuint64_t HashText(vuint64_t hash, const WString& text)
+{
+	vint length = text.Length();
+	hash = HashBytes(hash, &length, sizeof(length));
+	return HashBytes(hash, text.Buffer(), sizeof(wchar_t) * length);
+}
+
+/***********************************************************************
+HashWriter
+***********************************************************************/
+
+class HashWriter : public TextWriter
+{
+public:
+	vuint64_t							hash;
+
+	HashWriter(vuint64_t _hash)
+		:hash(_hash)
+	{
+	}
+
+	void WriteChar(wchar_t c)override
+	{
+		hash = HashBytes(hash, &c, sizeof(c));
+	}
+
+	void WriteString(const wchar_t* string, vint charCount)override
+	{
+		hash = HashBytes(hash, string, sizeof(wchar_t) * charCount);
+	}
+
+	using TextWriter::WriteString;
+};
+
+/***********************************************************************
+ComputePageHash
+***********************************************************************/
+
+vuint64_t ComputePageHash(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, IndexResult& result, SourceFileCache& sourceFiles)
+{
+	// GenerateFile only consumes the source file and collected lines, so they decide the hash
+	// referenced symbols are in the symbol database, which is not a part of any page
+	// spans are hashed by running WriteHtmlLine on them, so any change to its markup changes the hash
+	vuint64_t hash = 14695981039346656037ULL;
+	hash = HashBytes(hash, &PageFormatVersion, sizeof(PageFormatVersion));
+	hash = HashText(hash, flr->filePath.GetFullPath());
+	hash = HashText(hash, flr->htmlFileName);
+	hash = HashText(hash, sourceFiles.Get(flr->filePath)->text);
+
+	for (vint i = 0; i < flr->lines.Count(); i++)
+	{
+		vint lineNumber = flr->lines.Keys()[i];
+		auto& hlr = flr->lines.Values()[i];
+		hash = HashBytes(hash, &lineNumber, sizeof(lineNumber));
+		hash = HashBytes(hash, &hlr.lineCount, sizeof(hlr.lineCount));
+
+		HashWriter writer(hash);
+		WriteHtmlLine(flr, hlr, result, writer);
+		hash = writer.hash;
+	}
+	return hash;
+}
+
+/***********************************************************************
+ReadIndexDatabase
+***********************************************************************/
+
+void ReadIndexDatabase(FilePath pathDatabase, IndexDatabase& database)
+{
+	database.pageHashes.Clear();
+
+	File file(pathDatabase);
+	if (!file.Exists()) return;
+
+	List<WString> lines;
+	file.ReadAllLinesByBom(lines);
+	FOREACH(WString, line, lines)
+	{
+		vint index = line.IndexOf(L' ');
+		if (index == -1) continue;
+		database.pageHashes.Set(line.Sub(index + 1, line.Length() - index - 1), wtou64(line.Left(index)));
+	}
+}
+
+/***********************************************************************
+WriteIndexDatabase
+***********************************************************************/
+
+void WriteIndexDatabase(FilePath pathDatabase, IndexDatabase& database)
+{
+	FileStream fileStream(pathDatabase.GetFullPath(), FileStream::WriteOnly);
+	BomEncoder encoder(BomEncoder::Utf8);
+	EncoderStream encoderStream(fileStream, encoder);
+	StreamWriter writer(encoderStream);
+
+	for (vint i = 0; i < database.pageHashes.Count(); i++)
+	{
+		writer.WriteString(u64tow(database.pageHashes.Values()[i]));
+		writer.WriteString(L" ");
+		writer.WriteLine(database.pageHashes.Keys()[i]);
+	}
+}
\ No newline at end of file
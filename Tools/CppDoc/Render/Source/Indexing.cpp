@@ -24,6 +24,97 @@ IndexToken IndexToken::GetToken(CppName& name)
 	};
 }
 
+/***********************************************************************
+FlatIndex
+***********************************************************************/
+
+void FlatIndex::Build(IndexResult& result)
+{
+	// keys of decls and each index[reason] are sorted, merge them linearly and skip duplicated keys
+	auto& declKeys = result.decls.Keys();
+	vint declCursor = 0;
+	vint indexCursors[(vint)IndexReason::Max] = { 0 };
+
+	vint capacity = declKeys.Count();
+	for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
+	{
+		capacity += result.index[reason].Count();
+	}
+
+	rowStarts.Resize(capacity);
+	columnStarts.Resize(capacity);
+	rowEnds.Resize(capacity);
+	columnEnds.Resize(capacity);
+	decls.Resize(capacity);
+	for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
+	{
+		symbolBegins[reason].Resize(capacity);
+		symbolCounts[reason].Resize(capacity);
+	}
+	symbols.Clear();
+
+	vint count = 0;
+	while (true)
+	{
+		const IndexToken* key = nullptr;
+		if (declCursor < declKeys.Count())
+		{
+			key = &declKeys[declCursor];
+		}
+		for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
+		{
+			auto& indexKeys = result.index[reason].Keys();
+			if (indexCursors[reason] < indexKeys.Count())
+			{
+				auto& indexKey = indexKeys[indexCursors[reason]];
+				if (!key || IndexToken::Compare(indexKey, *key) < 0)
+				{
+					key = &indexKey;
+				}
+			}
+		}
+		if (!key) break;
+
+		rowStarts[count] = key->rowStart;
+		columnStarts[count] = key->columnStart;
+		rowEnds[count] = key->rowEnd;
+		columnEnds[count] = key->columnEnd;
+
+		decls[count] = nullptr;
+		if (declCursor < declKeys.Count() && IndexToken::Compare(declKeys[declCursor], *key) == 0)
+		{
+			decls[count] = result.decls.Values()[declCursor++].Obj();
+		}
+
+		for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
+		{
+			symbolBegins[reason][count] = symbols.Count();
+			symbolCounts[reason][count] = 0;
+
+			auto& index = result.index[reason];
+			vint& cursor = indexCursors[reason];
+			if (cursor < index.Count() && IndexToken::Compare(index.Keys()[cursor], *key) == 0)
+			{
+				auto& resolvedSymbols = index.GetByIndex(cursor++);
+				CopyFrom(symbols, resolvedSymbols, true);
+				symbolCounts[reason][count] = resolvedSymbols.Count();
+			}
+		}
+		count++;
+	}
+
+	rowStarts.Resize(count);
+	columnStarts.Resize(count);
+	rowEnds.Resize(count);
+	columnEnds.Resize(count);
+	decls.Resize(count);
+	for (vint reason = 0; reason < (vint)IndexReason::Max; reason++)
+	{
+		symbolBegins[reason].Resize(count);
+		symbolCounts[reason].Resize(count);
+	}
+}
+
 /***********************************************************************
 IndexRecorder
 ***********************************************************************/
@@ -38,21 +38,27 @@ void WriteMappingFile(FilePath pathMapping, List<TokenSkipping>& mapping)
 PreprocessedFileToCompactCodeAndMapping
 ***********************************************************************/
 
-void PreprocessedFileToCompactCodeAndMapping(Ptr<RegexLexer> lexer, FilePath pathInput, FilePath pathPreprocessed, FilePath pathOutput, FilePath pathMapping)
+Ptr<CppTokenReader> PreprocessedFileToCompactCodeAndMapping(Ptr<CppLexer> lexer, FilePath pathInput, FilePath pathPreprocessed, FilePath pathOutput, FilePath pathMapping, WString& preprocessed)
 {
-	WString input = File(pathInput).ReadAllTextByBom();
-	File(pathPreprocessed).WriteAllText(input, true, BomEncoder::Utf16);
+	// remaining tokens keep their positions in the preprocessed file, so Compile and Collect consume them without any mapping
+	// cache files are only for diagnosing, each of them is written only when its path is not empty
+	preprocessed = File(pathInput).ReadAllTextByBom();
+	if (pathPreprocessed.GetFullPath() != L"")
+	{
+		File(pathPreprocessed).WriteAllText(preprocessed, true, BomEncoder::Utf16);
+	}
 
 	List<TokenSkipping> mapping;
+	List<RegexToken> compacted;
+	Ptr<StreamHolder> holder;
+	if (pathOutput.GetFullPath() != L"")
 	{
-		CppTokenReader reader(lexer, input, false);
+		holder = new StreamHolder;
+	}
+	{
+		CppTokenReader reader(lexer, preprocessed, false);
 		auto cursor = reader.GetFirstToken();
 
-		FileStream fileStream(pathOutput.GetFullPath(), FileStream::WriteOnly);
-		BomEncoder encoder(BomEncoder::Utf16);
-		EncoderStream encoderStream(fileStream, encoder);
-		StreamWriter writer(encoderStream);
-
 		while (cursor)
 		{
 			switch ((CppTokens)cursor->token.token)
@@ -138,23 +144,44 @@ void PreprocessedFileToCompactCodeAndMapping(Ptr<RegexLexer> lexer, FilePath pat
 					}
 					else
 					{
-						// prevent from stack overflowing in CppTokenCursor's destructor
-						while (oldCursor != cursor)
+						mapping.Add(ts);
+						if (holder)
 						{
-							oldCursor = oldCursor->Next();
+							holder->streamWriter.WriteLine(L"", 0);
 						}
-						mapping.Add(ts);
-						writer.WriteLine(L"", 0);
 					}
 				}
 			}
 
 			if (cursor)
 			{
-				writer.WriteString(cursor->token.reading, cursor->token.length);
+				switch ((CppTokens)cursor->token.token)
+				{
+				case CppTokens::SPACE:
+				case CppTokens::COMMENT1:
+				case CppTokens::COMMENT2:
+					break;
+				default:
+					compacted.Add(cursor->token);
+				}
+
+				if (holder)
+				{
+					holder->streamWriter.WriteString(cursor->token.reading, cursor->token.length);
+				}
 				SkipToken(cursor);
 			}
 		}
 	}
-	WriteMappingFile(pathMapping, mapping);
+
+	if (holder)
+	{
+		holder->memoryStream.SeekFromBegin(0);
+		File(pathOutput).WriteAllText(StreamReader(holder->memoryStream).ReadToEnd(), true, BomEncoder::Utf16);
+	}
+	if (pathMapping.GetFullPath() != L"")
+	{
+		WriteMappingFile(pathMapping, mapping);
+	}
+	return new CppTokenReader(preprocessed, compacted);
 }
\ No newline at end of file
@@ -133,11 +133,11 @@ const wchar_t* GetSymbolDivClass(Symbol* symbol)
 WriteHtmlTextSingleLine
 ***********************************************************************/
 
-void WriteHtmlTextSingleLine(const WString& text, StreamWriter& writer)
+void WriteHtmlTextSingleLine(const wchar_t* text, vint length, StreamWriter& writer)
 {
-	auto reading = text.Buffer();
-	while (auto c = *reading++)
+	for (vint i = 0; i < length; i++)
 	{
+		auto c = text[i];
 		switch (c)
 		{
 		case L'<':
@@ -161,6 +161,11 @@ void WriteHtmlTextSingleLine(const WString& text, StreamWriter& writer)
 	}
 }
 
+void WriteHtmlTextSingleLine(const WString& text, StreamWriter& writer)
+{
+	WriteHtmlTextSingleLine(text.Buffer(), text.Length(), writer);
+}
+
 /***********************************************************************
 WriteHtmlTextSingleLine
 ***********************************************************************/
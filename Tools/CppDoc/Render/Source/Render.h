@@ -23,7 +23,7 @@ struct TokenSkipping
 
 extern void											ReadMappingFile(FilePath pathMapping, Array<TokenSkipping>& mapping);
 extern void											WriteMappingFile(FilePath pathMapping, List<TokenSkipping>& mapping);
-extern void											PreprocessedFileToCompactCodeAndMapping(Ptr<RegexLexer> lexer, FilePath pathInput, FilePath pathPreprocessed, FilePath pathOutput, FilePath pathMapping);
+extern Ptr<CppTokenReader>							PreprocessedFileToCompactCodeAndMapping(Ptr<CppLexer> lexer, FilePath pathInput, FilePath pathPreprocessed, FilePath pathOutput, FilePath pathMapping, WString& preprocessed);
 
 /***********************************************************************
 Indexing
@@ -58,6 +58,24 @@ enum class IndexReason
 using IndexMap = Group<IndexToken, Symbol*>;
 using ReverseIndexMap = Group<Symbol*, IndexToken>;
 
+struct IndexResult;
+
+// all keys in IndexResult::decls and IndexResult::index are merged into entries sorted by IndexToken, stored as struct of arrays
+struct FlatIndex
+{
+	Array<vint>										rowStarts;
+	Array<vint>										columnStarts;
+	Array<vint>										rowEnds;
+	Array<vint>										columnEnds;
+	Array<Declaration*>								decls;											// nullptr if the entry is not in IndexResult::decls
+	Array<vint>										symbolBegins[(vint)IndexReason::Max];			// symbols of an entry for each reason are symbols[symbolBegins[reason][entry] .. +symbolCounts[reason][entry]]
+	Array<vint>										symbolCounts[(vint)IndexReason::Max];
+	List<Symbol*>									symbols;
+
+	vint											Count()const { return rowStarts.Count(); }
+	void											Build(IndexResult& result);
+};
+
 struct IndexResult
 {
 	ParsingArguments								pa;
@@ -65,6 +83,7 @@ struct IndexResult
 	IndexMap										index[(vint)IndexReason::Max];
 	ReverseIndexMap									reverseIndex[(vint)IndexReason::Max];
 	Dictionary<IndexToken, Ptr<Declaration>>		decls;
+	FlatIndex										flatIndex;										// built from decls and index after compiling
 };
 
 class IndexRecorder : public Object, public virtual IIndexRecorder
@@ -84,35 +103,52 @@ public:
 Compiling
 ***********************************************************************/
 
-extern void											Compile(Ptr<RegexLexer> lexer, FilePath pathInput, IndexResult& result);
+extern void											Compile(Ptr<CppTokenReader> reader, IndexResult& result, Profiler& profiler);
 
 /***********************************************************************
 Token Indexing
 ***********************************************************************/
 
-struct AdjustSkippingResult
-{
-	vint											rowSkipped = 0;
-	vint											rowUntil = 0;
-	vint											columnUntil = 0;
-};
-
+// Collect scans FlatIndex together with tokens, both of them are sorted by position
 struct IndexTracking
 {
-	vint											index = 0;
-	bool											inRange = false;
+	vint											index = 0;										// the first entry that doesn't end before the current token
+	vint											declEntry = -1;									// the entry with a declaration covering the current token, or -1
+	vint											refEntries[(vint)IndexReason::Max] = { -1, -1, -1 };	// the entry with symbols of each reason covering the current token, or -1
 };
 
 /***********************************************************************
 Line Indexing
 ***********************************************************************/
 
+enum class HtmlSpanKind
+{
+	Text,											// text in GlobalLinesRecord::preprocessed, in a token div if divClass is not null
+	BeginDef,										// <div class="def" ...> for decl
+	EndDef,											// </div></div>
+	BeginRef,										// <div class="ref" ...> for symbols in IndexResult::flatIndex
+	EndRef,											// </div>
+};
+
+// HTML code is not built in Collect, spans are rendered when the page is generated
+struct HtmlSpan
+{
+	HtmlSpanKind									kind = HtmlSpanKind::Text;
+	const wchar_t*									divClass = nullptr;
+	const wchar_t*									reading = nullptr;
+	vint											length = 0;
+	Declaration*									decl = nullptr;
+	bool											generateLink = false;
+	vint											refEntries[(vint)IndexReason::Max] = { -1, -1, -1 };	// entry in IndexResult::flatIndex for each reason, -1 if not referenced
+};
+
 struct HtmlLineRecord
 {
 	vint											lineCount;
 	const wchar_t*									rawBegin;
 	const wchar_t*									rawEnd;
-	WString											htmlCode;
+	vint											spanBegin = 0;	// position in FileLinesRecord::spans
+	vint											spanCount = 0;
 };
 
 struct FileLinesRecord
@@ -120,6 +156,7 @@ struct FileLinesRecord
 	FilePath										filePath;
 	WString											htmlFileName;
 	Dictionary<vint, HtmlLineRecord>				lines;
+	List<HtmlSpan>									spans;
 	SortedList<Symbol*>								refSymbols;
 };
 
@@ -133,10 +170,7 @@ struct GlobalLinesRecord
 
 struct TokenTracker
 {
-	AdjustSkippingResult							asr;
-	IndexTracking									indexSkipping;
-	IndexTracking									indexDecl;
-	IndexTracking									indexResolve[(vint)IndexReason::Max];
+	IndexTracking									tracking;
 	bool											lastTokenIsDef = false;
 	bool											lastTokenIsRef = false;
 };
@@ -160,6 +194,7 @@ extern void											EnumerateDecls(Symbol* symbol, const Func<void(Ptr<Declara
 extern WString										GetDeclId(Ptr<Declaration> decl);
 extern WString										GetSymbolId(Symbol* symbol);
 extern const wchar_t*								GetSymbolDivClass(Symbol* symbol);
+extern void											WriteHtmlTextSingleLine(const wchar_t* text, vint length, StreamWriter& writer);
 extern void											WriteHtmlTextSingleLine(const WString& text, StreamWriter& writer);
 extern WString										HtmlTextSingleLineToString(const WString& text);
 extern void											WriteHtmlAttribute(const WString& text, StreamWriter& writer);
@@ -179,13 +214,55 @@ extern WString										GetSymbolDisplayNameInHtml(Symbol* symbol);
 Index Collecting
 ***********************************************************************/
 
-extern Ptr<GlobalLinesRecord>						Collect(Ptr<RegexLexer> lexer, FilePath pathPreprocessed, FilePath pathInput, FilePath pathMapping, IndexResult& result);
+extern Ptr<GlobalLinesRecord>						Collect(Ptr<CppLexer> lexer, const WString& preprocessed, IndexResult& result);
+
+/***********************************************************************
+Source File Caching
+***********************************************************************/
+
+// a line in SourceFile::text, without the line break
+struct SourceLine
+{
+	const wchar_t*									begin = nullptr;
+	vint											length = 0;
+
+	static bool										Read(const wchar_t*& reading, const wchar_t* end, SourceLine& line);
+	bool operator == (const SourceLine& l)const { return length == l.length && (length == 0 || wcsncmp(begin, l.begin, length) == 0); }
+	bool operator != (const SourceLine& l)const { return !(*this == l); }
+};
+
+class SourceFile : public Object
+{
+public:
+	WString											text;
+	List<SourceLine>								lines;
+
+	SourceFile(FilePath filePath);
+};
+
+// source files are loaded once and shared by all pages, including pages from different preprocessed files in the same run
+class SourceFileCache : public Object
+{
+protected:
+	SpinLock										lock;
+	Dictionary<FilePath, Ptr<SourceFile>>			files;
+
+public:
+	Ptr<SourceFile>									Get(FilePath filePath);
+};
 
 /***********************************************************************
 Source Code Page Generating
 ***********************************************************************/
 
-extern void											GenerateFile(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, IndexResult& result, FilePath pathHtml);
+extern void											GenerateFile(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, IndexResult& result, SourceFileCache& sourceFiles, FilePath pathHtml);
+
+/***********************************************************************
+Symbol Database Generating
+***********************************************************************/
+
+// symbols referenced by pages are written to shards in folderSymbols, Cpp.js loads them on demand
+extern void											GenerateSymbolDatabase(Ptr<GlobalLinesRecord> global, Folder folderSymbols);
 
 /***********************************************************************
 Index Page Generating
@@ -197,4 +274,23 @@ using FileGroupConfig = List<Tuple<WString, WString>>;
 extern void											GenerateFileIndex(Ptr<GlobalLinesRecord> global, FilePath pathHtml, FileGroupConfig& fileGroups);
 extern void											GenerateSymbolIndex(Ptr<GlobalLinesRecord> global, IndexResult& result, FilePath pathHtml, FileGroupConfig& fileGroups);
 
+/***********************************************************************
+Incremental Generating
+***********************************************************************/
+
+// increase it whenever GenerateFile or GenerateCppCodeInHtml changes the generated markup, so that pages from an older generator are regenerated
+// markup from WriteHtmlLine is a part of the page hash, so it doesn't need this
+constexpr vuint64_t									PageFormatVersion = 1;
+
+struct IndexDatabase
+{
+	Dictionary<WString, vuint64_t>					pageHashes;		// htmlFileName -> hash of everything the page is generated from
+};
+
+extern vuint64_t									HashBytes(vuint64_t hash, const void* buffer, vint size);
+extern void											WriteHtmlLine(Ptr<FileLinesRecord> flr, const HtmlLineRecord& hlr, IndexResult& result, TextWriter& writer);
+extern vuint64_t									ComputePageHash(Ptr<GlobalLinesRecord> global, Ptr<FileLinesRecord> flr, IndexResult& result, SourceFileCache& sourceFiles);
+extern void											ReadIndexDatabase(FilePath pathDatabase, IndexDatabase& database);
+extern void											WriteIndexDatabase(FilePath pathDatabase, IndexDatabase& database);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "Render.h"
+
+/***********************************************************************
+SourceLine
+***********************************************************************/
+
+bool SourceLine::Read(const wchar_t*& reading, const wchar_t* end, SourceLine& line)
+{
+	// lines are split in the same way as TextReader::ReadLine, a trailing '\r' is not a part of a line
+	// returns false if the line is not ended by '\n', reading after the end always gets an empty line
+	line.begin = reading;
+	while (reading < end && *reading != L'\n')
+	{
+		reading++;
+	}
+	line.length = (vint)(reading - line.begin);
+	if (line.length > 0 && line.begin[line.length - 1] == L'\r')
+	{
+		line.length--;
+	}
+
+	if (reading == end) return false;
+	reading++;
+	return true;
+}
+
+/***********************************************************************
+SourceFile
+***********************************************************************/
+
+SourceFile::SourceFile(FilePath filePath)
+	:text(File(filePath).ReadAllTextByBom())
+{
+	auto reading = text.Buffer();
+	auto end = reading + text.Length();
+	// like File::ReadAllLinesByBom, the text after the last '\n' is always a line even if it is empty
+	SourceLine line;
+	while (SourceLine::Read(reading, end, line))
+	{
+		lines.Add(line);
+	}
+	lines.Add(line);
+}
+
+/***********************************************************************
+SourceFileCache
+***********************************************************************/
+
+Ptr<SourceFile> SourceFileCache::Get(FilePath filePath)
+{
+	SPIN_LOCK(lock)
+	{
+		vint index = files.Keys().IndexOf(filePath);
+		if (index != -1) return files.Values()[index];
+	}
+
+	// loading is done outside of the lock, if two pages race for the same file, the first one wins
+	auto sourceFile = MakePtr<SourceFile>(filePath);
+	SPIN_LOCK(lock)
+	{
+		vint index = files.Keys().IndexOf(filePath);
+		if (index != -1) return files.Values()[index];
+		files.Add(filePath, sourceFile);
+	}
+	return sourceFile;
+}
\ No newline at end of file
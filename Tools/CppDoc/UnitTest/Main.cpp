@@ -1,8 +1,8 @@
 #include <Lexer.h>
 
-Ptr<RegexLexer> cppLexer;
+Ptr<CppLexer> cppLexer;
 
-Ptr<RegexLexer> GlobalCppLexer()
+Ptr<CppLexer> GlobalCppLexer()
 {
 	return cppLexer;
 }
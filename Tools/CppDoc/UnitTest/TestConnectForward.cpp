@@ -351,4 +351,108 @@ namespace a
 			}
 		});
 	});
+	TEST_CATEGORY(L"Children of a scope")
+	{
+		WString input = L"namespace a {";
+		for (vint i = 999; i >= 0; i--)
+		{
+			input += L" int x" + itow(i) + L"; extern int y" + itow(i % 10) + L";";
+		}
+		input += L" }";
+		COMPILE_PROGRAM(program, pa, input.Buffer());
+
+		TEST_CASE(L"Looking up children")
+		{
+			auto& children = pa.root->TryGetChildren_NFb(L"a")->Get(0)->GetChildren_NFb();
+			TEST_ASSERT(children.Count() == 1010);
+			for (vint i = 0; i < 1000; i++)
+			{
+				auto pSymbols = children.TryGet(L"x" + itow(i));
+				TEST_ASSERT(pSymbols && pSymbols->Count() == 1);
+				TEST_ASSERT(pSymbols->Get(0)->kind == symbol_component::SymbolKind::Variable);
+			}
+			for (vint i = 0; i < 10; i++)
+			{
+				auto pSymbols = children.TryGet(L"y" + itow(i));
+				TEST_ASSERT(pSymbols && pSymbols->Count() == 1);
+				TEST_ASSERT(!pSymbols->Get(0)->GetImplDecl_NFb());
+				TEST_ASSERT(pSymbols->Get(0)->GetForwardDecls_N().Count() == 100);
+			}
+			TEST_ASSERT(children.TryGet(L"x1000") == nullptr);
+			TEST_ASSERT(children.TryGet(L"a") == nullptr);
+		});
+
+		TEST_CASE(L"Enumerating children in the order of names")
+		{
+			auto& children = pa.root->TryGetChildren_NFb(L"a")->Get(0)->GetChildren_NFb();
+			for (vint i = 1; i < children.Count(); i++)
+			{
+				TEST_ASSERT(children.GetByIndex(i - 1)[0]->name < children.GetByIndex(i)[0]->name);
+			}
+		});
+
+		TEST_CASE(L"Adding and removing children between enumerations")
+		{
+			auto a = MakePtr<Symbol>(symbol_component::SymbolCategory::Normal);
+			auto b = MakePtr<Symbol>(symbol_component::SymbolCategory::Normal);
+			auto c = MakePtr<Symbol>(symbol_component::SymbolCategory::Normal);
+			symbol_component::SymbolGroup children;
+
+			children.Add(L"c", c);
+			children.Add(L"a", a);
+			children.SortEntries();
+			TEST_ASSERT(children.Count() == 2);
+			TEST_ASSERT(children.GetByIndex(0)[0] == a);
+			TEST_ASSERT(children.GetByIndex(1)[0] == c);
+
+			children.Add(L"b", b);
+			children.Remove(L"a", a.Obj());
+			children.SortEntries();
+			TEST_ASSERT(children.Count() == 2);
+			TEST_ASSERT(children.GetByIndex(0)[0] == b);
+			TEST_ASSERT(children.GetByIndex(1)[0] == c);
+
+			children.Add(L"a", a);
+			children.Remove(L"c", c.Obj());
+			children.Add(L"c", c);
+			children.SortEntries();
+			TEST_ASSERT(children.Count() == 3);
+			TEST_ASSERT(children.GetByIndex(0)[0] == a);
+			TEST_ASSERT(children.GetByIndex(1)[0] == b);
+			TEST_ASSERT(children.GetByIndex(2)[0] == c);
+			TEST_ASSERT(children.GetByIndex(2).Count() == 1);
+		});
+	});
+
+	TEST_CATEGORY(L"Many overloaded functions")
+	{
+		WString input = L"namespace a {";
+		for (vint i = 0; i < 200; i++)
+		{
+			input += L" struct S" + itow(i) + L"{}; void F(S" + itow(i) + L"); template<typename T> T F(T, S" + itow(i) + L"*);";
+		}
+		for (vint i = 199; i >= 0; i--)
+		{
+			input += L" template<typename U> U F(U, S" + itow(i) + L"*){} void F(S" + itow(i) + L"){}";
+		}
+		input += L" }";
+		COMPILE_PROGRAM(program, pa, input.Buffer());
+
+		TEST_CASE(L"Checking connections")
+		{
+			auto pSymbols = pa.root->TryGetChildren_NFb(L"a")->Get(0)->TryGetChildren_NFb(L"F");
+			TEST_ASSERT(pSymbols && pSymbols->Count() == 400);
+			for (vint i = 0; i < pSymbols->Count(); i++)
+			{
+				auto symbol = pSymbols->Get(i).Obj();
+				TEST_ASSERT(symbol->GetForwardSymbols_F().Count() == 1);
+				TEST_ASSERT(symbol->GetImplSymbols_F().Count() == 1);
+
+				auto forwardDecl = symbol->GetForwardSymbols_F()[0]->GetForwardDecl_Fb().Cast<ForwardFunctionDeclaration>();
+				auto implDecl = symbol->GetImplSymbols_F()[0]->GetImplDecl_NFb<FunctionDeclaration>();
+				TEST_ASSERT((forwardDecl->templateSpec == nullptr) == (implDecl->templateSpec == nullptr));
+				TEST_ASSERT(GetFunctionSignatureInSameScope(forwardDecl) == GetFunctionSignatureInSameScope(implDecl));
+			}
+		});
+	});
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include <Lexer.h>
 
-extern Ptr<RegexLexer> GlobalCppLexer();
+extern Ptr<CppLexer> GlobalCppLexer();
 
 vint CheckTokens(List<RegexToken>& tokens)
 {
@@ -282,13 +282,37 @@ vint CheckTokens(List<RegexToken>& tokens)
 	return tokens.Count();
 }
 
+void AssertSameTokens(Ptr<RegexLexer> regexLexer, const WString& input)
+{
+	List<RegexToken> expected, actual;
+	regexLexer->Parse(input).ReadToEnd(expected);
+	GlobalCppLexer()->Parse(input, actual);
+
+	TEST_ASSERT(expected.Count() == actual.Count());
+	for (vint i = 0; i < expected.Count(); i++)
+	{
+		auto& a = expected[i];
+		auto& b = actual[i];
+		TEST_ASSERT(a.start == b.start);
+		TEST_ASSERT(a.length == b.length);
+		TEST_ASSERT(a.token == b.token);
+		TEST_ASSERT(a.reading == b.reading);
+		TEST_ASSERT(a.codeIndex == b.codeIndex);
+		TEST_ASSERT(a.completeToken == b.completeToken);
+		TEST_ASSERT(a.rowStart == b.rowStart);
+		TEST_ASSERT(a.columnStart == b.columnStart);
+		TEST_ASSERT(a.rowEnd == b.rowEnd);
+		TEST_ASSERT(a.columnEnd == b.columnEnd);
+	}
+}
+
 TEST_FILE
 {
 	TEST_CASE(L"Punctuators")
 	{
 		WString input = LR"({}[]()<>=!%:;.?,*+-/^&|~#)";
 		List<RegexToken> tokens;
-		GlobalCppLexer()->Parse(input).ReadToEnd(tokens);
+		GlobalCppLexer()->Parse(input, tokens);
 		TEST_ASSERT(CheckTokens(tokens) == 25);
 	});
 
@@ -315,7 +339,7 @@ TEST_FILE
 .456e-10L
 )";
 		List<RegexToken> tokens;
-		GlobalCppLexer()->Parse(input).ReadToEnd(tokens);
+		GlobalCppLexer()->Parse(input, tokens);
 		TEST_ASSERT(CheckTokens(tokens) == 37);
 	});
 
@@ -334,7 +358,7 @@ U'\''
 u8'\''
 )";
 		List<RegexToken> tokens;
-		GlobalCppLexer()->Parse(input).ReadToEnd(tokens);
+		GlobalCppLexer()->Parse(input, tokens);
 		TEST_ASSERT(CheckTokens(tokens) == 21);
 	});
 
@@ -353,7 +377,7 @@ u8'\''
 /* x***x */
 )";
 		List<RegexToken> tokens;
-		GlobalCppLexer()->Parse(input).ReadToEnd(tokens);
+		GlobalCppLexer()->Parse(input, tokens);
 		TEST_ASSERT(CheckTokens(tokens) == 21);
 	});
 
@@ -368,10 +392,92 @@ int main()
 }
 )";
 		List<RegexToken> tokens;
-		GlobalCppLexer()->Parse(input).ReadToEnd(tokens);
+		GlobalCppLexer()->Parse(input, tokens);
 		TEST_ASSERT(CheckTokens(tokens) == 31);
 	});
 
+	TEST_CASE(L"Keywords")
+	{
+#define ASSERT_KEYWORD(NAME, KEYWORD)\
+		TEST_ASSERT(CppLexer::ClassifyIdentifier(L#KEYWORD, wcslen(L#KEYWORD)) == CppTokens::NAME);\
+		TEST_ASSERT(CppLexer::ClassifyIdentifier(L#KEYWORD L"_", wcslen(L#KEYWORD) + 1) == CppTokens::ID);\
+		TEST_ASSERT(CppLexer::ClassifyIdentifier(L#KEYWORD, wcslen(L#KEYWORD) - 1) == CppTokens::ID);\
+
+		CPP_KEYWORD_TOKENS(ASSERT_KEYWORD)
+#undef ASSERT_KEYWORD
+
+		TEST_ASSERT(CppLexer::ClassifyIdentifier(L"Class", 5) == CppTokens::ID);
+		TEST_ASSERT(CppLexer::ClassifyIdentifier(L"__int128", 8) == CppTokens::ID);
+		TEST_ASSERT(CppLexer::ClassifyIdentifier(L"static_assert_", 14) == CppTokens::ID);
+	});
+
+	TEST_CASE(L"CppLexer and RegexLexer")
+	{
+		auto regexLexer = CreateCppRegexLexer();
+		const wchar_t* inputs[] = {
+			L"",
+			L"class classes _class Class __if_exists __if_not_exists static_assert",
+			L"1 1u 1uu 1ull 1lul 1llu 1lll 1'000'000 1'' 0x 0x1fUL 0xg 0b 0b012 0B1lU 00",
+			L"1. .1 1.2 1.e5 1e5 .5e+ .5e-3f 1.2.3 1..2 ... .f 1.fL",
+			L"\"abc\" L\"a\\\"b\" u8\"x\" u8'x' U'\\'' u\"\n\" L u8 uL\"x\" \"multi\nline\"",
+			L"// comment\r\n/// document\n///\n//\n/**/ /***/ /* a * b ** / */ /*/ */",
+			L" \t\r\n\v\f{}[]()<>=!%:;.?,*+-/^&|~#",
+			L"\"unterminated",
+			L"'unterminated",
+			L"x /* unterminated",
+			L"a @ b $ c \\ d `",
+			L"int main()\n{\n\treturn 0;\n}\n",
+		};
+
+		const vint InputCount = sizeof(inputs) / sizeof(*inputs);
+		for (vint i = 0; i < InputCount; i++)
+		{
+			AssertSameTokens(regexLexer, inputs[i]);
+		}
+	});
+
+	TEST_CASE(L"CppLexer and RegexLexer on spaces, comments and strings")
+	{
+		// special characters are put at every position of long tokens, so that they are found in and across vectors
+		auto regexLexer = CreateCppRegexLexer();
+		const wchar_t* specials[] = { L"*", L"/", L"\\", L"\"", L"'", L"\r", L"\n", L" ", L"\t", L"x" };
+		const vint SpecialCount = sizeof(specials) / sizeof(*specials);
+		const wchar_t* tokens[][3] = {
+			{ L" ",		L" ",		L"" },
+			{ L"\r\n",	L"\t",		L"" },
+			{ L"//",	L"x",		L"" },
+			{ L"///",	L"x",		L"" },
+			{ L"/*",	L"x",		L"*/" },
+			{ L"\"",	L"x",		L"\"" },
+			{ L"u8\"",	L"x",		L"\"" },
+			{ L"'",		L"x",		L"'" },
+		};
+		const vint TokenCount = sizeof(tokens) / sizeof(*tokens);
+
+		for (vint i = 0; i < TokenCount; i++)
+		{
+			for (vint before = 0; before < 20; before++)
+			{
+				for (vint a = 0; a < SpecialCount; a++)
+				{
+					for (vint b = 0; b < SpecialCount; b++)
+					{
+						for (vint c = 0; c < SpecialCount; c++)
+						{
+							WString input = tokens[i][0];
+							for (vint j = 0; j < before; j++) input += tokens[i][1];
+							input += WString(specials[a]) + specials[b] + specials[c];
+							for (vint j = 0; j < 9; j++) input += tokens[i][1];
+							input += tokens[i][2];
+							input += L";";
+							AssertSameTokens(regexLexer, input);
+						}
+					}
+				}
+			}
+		}
+	});
+
 	//TEST_CASE(L"GacUI")
 	//{
 	//	FilePath inputPath = L"../../../.Output/Import/Preprocessed.txt";
@@ -380,7 +486,7 @@ int main()
 	//	wchar_t* buffer = ReadBigFile(inputPath);
 	//
 	//	List<RegexToken> tokens;
-	//	GlobalCppLexer()->Parse(WString(buffer, false)).ReadToEnd(tokens);
+	//	GlobalCppLexer()->Parse(WString(buffer, false), tokens);
 	//	CheckTokens(tokens);
 	//	delete[] buffer;
 	//});
@@ -412,7 +518,7 @@ int main()
 		const vint TokenCount = sizeof(output) / sizeof(*output);
 
 		vint counts[CursorCount] = { 0 };
-		Ptr<CppTokenCursor> cursors[CursorCount];
+		CppTokenCursor* cursors[CursorCount];
 		for (vint i = 0; i < CursorCount; i++)
 		{
 			if (i == 0)
@@ -473,7 +579,8 @@ int main()
 		const vint TokenCount = sizeof(output) / sizeof(*output);
 
 		Ptr<CppTokenReader> reader1, reader2;
-		Ptr<CppTokenCursor> cursor1, cursor2;
+		CppTokenCursor* cursor1 = nullptr;
+		CppTokenCursor* cursor2 = nullptr;
 
 		reader1 = MakePtr<CppTokenReader>(GlobalCppLexer(), input);
 		cursor1 = reader1->GetFirstToken();
@@ -388,6 +388,24 @@ TEST_FILE
 		ASSERT_OVERLOADING_SIMPLE(F({0}),			char);
 	});
 
+	TEST_CATEGORY(L"Many overloads")
+	{
+		const vint count = 300;
+		WString input;
+		for (vint i = 0; i < count; i++)
+		{
+			input += L"struct S" + itow(i) + L"{}; S" + itow(i) + L"* F(S" + itow(i) + L");\r\n";
+		}
+		COMPILE_PROGRAM(program, pa, input.Buffer());
+
+		for (vint i = 0; i < count; i += 37)
+		{
+			auto call = L"F(S" + itow(i) + L"())";
+			auto type = L"::S" + itow(i) + L" * $PR";
+			AssertExpr(pa, call.Buffer(), call.Buffer(), type.Buffer());
+		}
+	});
+
 	TEST_CATEGORY(L"Initialization list")
 	{
 		// TODO:
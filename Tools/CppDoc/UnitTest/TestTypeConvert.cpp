@@ -634,6 +634,63 @@ TEST_FILE
 		TEST_CONV_TYPE(Source&&,			TargetB&&,									F,	F);
 	#undef F
 	});
+
+	TEST_CATEGORY(L"Test type conversion cache")
+	{
+		ParsingArguments pa(new Symbol(symbol_component::SymbolCategory::Normal), ITsysAlloc::Create(), nullptr);
+		auto& cache = pa.tsys->GetTypeConvCache();
+		auto fromType = pa.tsys->Int();
+		auto toType = pa.tsys->PrimitiveOf({ TsysPrimitiveType::Float,TsysBytes::_8 });
+
+		TEST_CASE(L"Identical conversions are only tested once")
+		{
+			TEST_ASSERT(TestTypeConversion(pa, toType, { nullptr,ExprTsysType::PRValue,fromType }).cat == TypeConvCat::Standard);
+			TEST_ASSERT(cache.GetHitCount() == 0);
+			TEST_ASSERT(cache.GetMissCount() == 1);
+
+			TEST_ASSERT(TestTypeConversion(pa, toType, { nullptr,ExprTsysType::PRValue,fromType }).cat == TypeConvCat::Standard);
+			TEST_ASSERT(cache.GetHitCount() == 1);
+			TEST_ASSERT(cache.GetMissCount() == 1);
+
+			TEST_ASSERT(TestTypeConversion(pa, fromType, { nullptr,ExprTsysType::PRValue,toType }).cat == TypeConvCat::Standard);
+			TEST_ASSERT(cache.GetHitCount() == 1);
+			TEST_ASSERT(cache.GetMissCount() == 2);
+		});
+	});
+
+	TEST_CATEGORY(L"Test type conversion cache with incomplete classes")
+	{
+		TEST_DECL(
+			struct Incomplete;
+			struct Complete
+			{
+				Complete(int);
+			};
+		);
+		COMPILE_PROGRAM(program, pa, input);
+
+		TEST_CASE(L"Conversions to incomplete classes are not cached")
+		{
+			auto& cache = pa.tsys->GetTypeConvCache();
+			auto tInt = pa.tsys->Int();
+			auto tIncomplete = pa.tsys->DeclOf(pa.root->TryGetChildren_NFb(L"Incomplete")->Get(0).Obj());
+			auto tComplete = pa.tsys->DeclOf(pa.root->TryGetChildren_NFb(L"Complete")->Get(0).Obj());
+			vint hits = cache.GetHitCount();
+
+			for (vint i = 0; i < 2; i++)
+			{
+				TEST_ASSERT(TestTypeConversion(pa, tIncomplete, { nullptr,ExprTsysType::PRValue,tInt }).cat == TypeConvCat::Illegal);
+				TEST_ASSERT(TestTypeConversion(pa, tIncomplete->PtrOf(), { nullptr,ExprTsysType::PRValue,tInt->PtrOf() }).cat == TypeConvCat::Illegal);
+			}
+			TEST_ASSERT(cache.GetHitCount() == hits);
+
+			for (vint i = 0; i < 2; i++)
+			{
+				TEST_ASSERT(TestTypeConversion(pa, tComplete, { nullptr,ExprTsysType::PRValue,tInt }).cat == TypeConvCat::UserDefined);
+			}
+			TEST_ASSERT(cache.GetHitCount() == hits + 1);
+		});
+	});
 }
 
 #undef TEST_CONV_TYPE
@@ -108,6 +108,35 @@ TEST_FILE
 		TEST_ASSERT(tvoid->FunctionOf(types1, data1) != tvoid->FunctionOf(types2, data1));
 	});
 
+	TEST_CASE(L"Test function type creation with many parameter lists")
+	{
+		auto tsys = ITsysAlloc::Create();
+		auto tvoid = tsys->Void();
+		auto tint = tsys->Int();
+
+		List<ITsys*> functions;
+		for (vint i = 0; i < 100; i++)
+		{
+			List<ITsys*> types;
+			for (vint j = 0; j < i; j++)
+			{
+				types.Add(tint);
+			}
+			functions.Add(tvoid->FunctionOf(types, {}));
+		}
+
+		for (vint i = 0; i < 100; i++)
+		{
+			List<ITsys*> types;
+			for (vint j = 0; j < i; j++)
+			{
+				types.Add(tint);
+			}
+			TEST_ASSERT(tvoid->FunctionOf(types, {}) == functions[i]);
+			TEST_ASSERT(functions[i]->GetParamCount() == i);
+		}
+	});
+
 	TEST_CASE(L"Test member type creation")
 	{
 		auto tsys = ITsysAlloc::Create();
@@ -355,4 +384,145 @@ TEST_FILE
 		TEST_ASSERT(tvoid->FunctionOf(types, {})->GetType() == TsysType::Function);
 		TEST_ASSERT(tvoid->GenericFunctionOf(types, gf)->GetType() == TsysType::GenericFunction);
 	});
+
+	TEST_CASE(L"Test type header")
+	{
+		auto n1 = MakePtr<Symbol>();
+		auto tsys = ITsysAlloc::Create();
+		auto tint = tsys->Int();
+		auto tdecl = tsys->DeclOf(n1.Obj());
+		auto tconst = tint->CVOf({ true,false });
+
+		TsysCV cv;
+		TsysRefType refType;
+		TEST_ASSERT(tint->GetEntity(cv, refType) == tint);
+		TEST_ASSERT(!cv.isGeneralConst && !cv.isVolatile && refType == TsysRefType::None);
+		TEST_ASSERT(tconst->GetCV().isGeneralConst && !tconst->GetCV().isVolatile);
+		TEST_ASSERT(tconst->GetElement() == tint);
+		TEST_ASSERT(tconst->GetEntity(cv, refType) == tint);
+		TEST_ASSERT(cv.isGeneralConst && !cv.isVolatile && refType == TsysRefType::None);
+		TEST_ASSERT(tconst->LRefOf()->GetEntity(cv, refType) == tint);
+		TEST_ASSERT(cv.isGeneralConst && !cv.isVolatile && refType == TsysRefType::LRef);
+		TEST_ASSERT(tconst->RRefOf()->GetEntity(cv, refType) == tint);
+		TEST_ASSERT(cv.isGeneralConst && !cv.isVolatile && refType == TsysRefType::RRef);
+		TEST_ASSERT(tint->PtrOf()->LRefOf()->GetEntity(cv, refType) == tint->PtrOf());
+		TEST_ASSERT(!cv.isGeneralConst && !cv.isVolatile && refType == TsysRefType::LRef);
+
+		TEST_ASSERT(tint->ArrayOf(3)->GetElement() == tint);
+		TEST_ASSERT(tint->ArrayOf(3)->GetArrayDimensions() == 3);
+		TEST_ASSERT(tint->ArrayOf(3)->GetParamCount() == 0);
+
+		List<ITsys*> types;
+		types.Add(tdecl);
+		types.Add(tconst);
+		auto tfunc = tint->FunctionOf(types, {});
+		TEST_ASSERT(tfunc->GetElement() == tint);
+		TEST_ASSERT(tfunc->GetParamCount() == 2);
+		TEST_ASSERT(tfunc->GetParam(0) == tdecl);
+		TEST_ASSERT(tfunc->GetParam(1) == tconst);
+		TEST_ASSERT(tint->FunctionOf(types, {}) == tfunc);
+
+		types.Clear();
+		auto tfunc0 = tint->FunctionOf(types, {});
+		TEST_ASSERT(tfunc0 != tfunc);
+		TEST_ASSERT(tfunc0->GetParamCount() == 0);
+	});
+
+	TEST_CASE(L"Test ExprTsysList")
+	{
+		auto tsys = ITsysAlloc::Create();
+		List<Ptr<Symbol>> symbols;
+		for (vint i = 0; i < 100; i++)
+		{
+			symbols.Add(MakePtr<Symbol>());
+		}
+
+		auto item = [&](vint i)
+		{
+			return ExprTsysItem(symbols[i].Obj(), ExprTsysType::PRValue, tsys->DeclOf(symbols[i].Obj()));
+		};
+
+		ExprTsysList list;
+		for (vint i = 0; i < symbols.Count(); i++)
+		{
+			TEST_ASSERT(!list.Contains(item(i)));
+			TEST_ASSERT(list.Add(item(i)) == i);
+			TEST_ASSERT(list.Count() == i + 1);
+			for (vint j = 0; j <= i; j++)
+			{
+				TEST_ASSERT(list.IndexOf(item(j)) == j);
+			}
+		}
+		TEST_ASSERT(!list.Contains({ symbols[0].Obj(),ExprTsysType::LValue,tsys->DeclOf(symbols[0].Obj()) }));
+		TEST_ASSERT(!list.Contains({ symbols[0].Obj(),ExprTsysType::PRValue,tsys->DeclOf(symbols[1].Obj()) }));
+
+		TEST_ASSERT(list.Add(item(50)) == 100);
+		TEST_ASSERT(list.IndexOf(item(50)) == 50);
+
+		TEST_ASSERT(list.RemoveAt(50));
+		TEST_ASSERT(list.Count() == 100);
+		TEST_ASSERT(list.IndexOf(item(50)) == 99);
+		TEST_ASSERT(list.IndexOf(item(51)) == 50);
+		TEST_ASSERT(list.IndexOf(item(99)) == 98);
+
+		ExprTsysList moved(MoveValue(list));
+		TEST_ASSERT(list.Count() == 0);
+		TEST_ASSERT(!list.Contains(item(0)));
+		TEST_ASSERT(moved.Count() == 100);
+		TEST_ASSERT(moved.IndexOf(item(0)) == 0);
+
+		List<ExprTsysItem> copied;
+		CopyFrom(copied, moved);
+		TEST_ASSERT(copied.Count() == 100);
+		vint index = 0;
+		FOREACH(ExprTsysItem, copiedItem, moved)
+		{
+			TEST_ASSERT(ExprTsysItem::Compare(copiedItem, copied[index++]) == 0);
+		}
+		TEST_ASSERT(index == 100);
+
+		TEST_ASSERT(moved.Clear());
+		TEST_ASSERT(moved.Count() == 0);
+		TEST_ASSERT(!moved.Contains(item(0)));
+		TEST_ASSERT(moved.Add(item(1)) == 0);
+		TEST_ASSERT(moved.IndexOf(item(1)) == 0);
+	});
+
+	TEST_CASE(L"Test CreateUniversalInitializerType")
+	{
+		ParsingArguments pa(new Symbol(symbol_component::SymbolCategory::Normal), ITsysAlloc::Create(), nullptr);
+		auto tInt = pa.tsys->Int();
+		auto tBool = pa.tsys->PrimitiveOf({ TsysPrimitiveType::Bool,TsysBytes::_1 });
+		auto tVoid = pa.tsys->Void();
+
+		Array<ExprTsysList> argTypesList(3);
+		argTypesList[0].Add({ nullptr,ExprTsysType::PRValue,tInt });
+		argTypesList[0].Add({ nullptr,ExprTsysType::PRValue,tBool });
+		argTypesList[0].Add({ nullptr,ExprTsysType::PRValue,tInt });
+		argTypesList[1].Add({ nullptr,ExprTsysType::LValue,tVoid });
+		argTypesList[2].Add({ nullptr,ExprTsysType::PRValue,tBool });
+		argTypesList[2].Add({ nullptr,ExprTsysType::PRValue,tInt });
+
+		symbol_type_resolving::CartesianProduct product(argTypesList);
+		TEST_ASSERT(product.GetSize() == 4);
+
+		ExprTsysList result;
+		symbol_type_resolving::CreateUniversalInitializerType(pa, argTypesList, result);
+		TEST_ASSERT(result.Count() == 4);
+		TEST_ASSERT(result[0].tsys->GetParam(0) == tInt && result[0].tsys->GetParam(2) == tBool);
+		TEST_ASSERT(result[1].tsys->GetParam(0) == tInt && result[1].tsys->GetParam(2) == tInt);
+		TEST_ASSERT(result[2].tsys->GetParam(0) == tBool && result[2].tsys->GetParam(2) == tBool);
+		TEST_ASSERT(result[3].tsys->GetParam(0) == tBool && result[3].tsys->GetParam(2) == tInt);
+
+		vint overLimit = profilerCounters[(vint)ProfilerCounter::CartesianProductOverLimit];
+		vint maxSize = symbol_type_resolving::MaxCartesianProductSize;
+		symbol_type_resolving::MaxCartesianProductSize = 3;
+		result.Clear();
+		symbol_type_resolving::CreateUniversalInitializerType(pa, argTypesList, result);
+		symbol_type_resolving::MaxCartesianProductSize = maxSize;
+
+		TEST_ASSERT(result.Count() == 1);
+		TEST_ASSERT(result[0].tsys == pa.tsys->Any());
+		TEST_ASSERT(profilerCounters[(vint)ProfilerCounter::CartesianProductOverLimit] == overLimit + 1);
+	});
 }
\ No newline at end of file
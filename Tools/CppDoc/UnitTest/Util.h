@@ -8,7 +8,7 @@
 using namespace vl::stream;
 using namespace vl::filesystem;
 
-extern Ptr<RegexLexer>		GlobalCppLexer();
+extern Ptr<CppLexer>		GlobalCppLexer();
 extern void					Log(Ptr<Type> type, StreamWriter& writer);
 extern void					Log(Ptr<Expr> expr, StreamWriter& writer);
 extern void					Log(Ptr<Stat> stat, StreamWriter& writer, vint indentation);
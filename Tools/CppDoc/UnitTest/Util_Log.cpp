@@ -1488,7 +1488,7 @@ void Log(ITsys* tsys, StreamWriter& writer)
 		{
 			Log(tsys->GetElement(), writer);
 			writer.WriteString(L" [");
-			vint dim = tsys->GetParamCount();
+			vint dim = tsys->GetArrayDimensions();
 			for (vint i = 1; i < dim; i++)
 			{
 				writer.WriteChar(L',');
@@ -1,7 +1,9 @@
 
 let lastFocusedElement = undefined;
-let referencedSymbols = undefined;
-let symbolToFiles = undefined;
+let currentHtmlFileName = undefined;
+let symbolShards = undefined;
+const scriptLoadings = {};
+const loadedSymbolShards = {};
 
 function turnOffCurrentSymbol() {
     if (lastFocusedElement !== undefined) {
@@ -132,6 +134,29 @@ function promptTooltipDropdownData(dropdownData, underElement) {
  *   }[]
  * }[]
  *
+ * symbolShards: {                  // ./Symbols/Shards.js
+ *   count: number,                 // a power of 2
+ *   files: string[]                // ./Symbols/{files[i]}.js calls registerSymbolShard(i, ...)
+ * }
+ *
+ * referencedSymbols: {             // a symbol shard
+ *   [key: string]: {
+ *     displayNameInHtml: string,
+ *     impls: DeclFile[],
+ *     decls: DeclFile[]
+ *   }
+ * }
+ *
+ * DeclFile: {
+ *   elementId: string,
+ *   file: null | {                 // null if the declaration is not rendered
+ *     htmlFileName: string,
+ *     displayName: string
+ *   }
+ * }
+ *
+ * Pages generated before the symbol database inline their own data instead:
+ *
  * referencedSymbols: {
  *   [key: string]: {
  *     displayNameInHtml: string,
@@ -141,15 +166,112 @@ function promptTooltipDropdownData(dropdownData, underElement) {
  * }
  *
  * symbolToFiles: {
- *   [key: string]: null | {
+ *   [key: string]: null | {        // null if the declaration is in this page, undefined if it is not rendered
  *     htmlFileName: string,
  *     displayName: string
  *   }
  * }
  */
 
-function jumpToSymbol(overloadResolutions, resolved) {
+function loadScript(src) {
+    return new Promise(function (resolve, reject) {
+        const scriptElement = document.createElement('script');
+        scriptElement.src = src;
+        scriptElement.onload = resolve;
+        scriptElement.onerror = reject;
+        document.head.appendChild(scriptElement);
+    });
+}
+
+function loadScriptOnce(src) {
+    // a failed loading is not cached, so that it could be retried
+    if (scriptLoadings[src] === undefined) {
+        scriptLoadings[src] = loadScript(src).catch(function (error) {
+            delete scriptLoadings[src];
+            throw error;
+        });
+    }
+    return scriptLoadings[src];
+}
+
+function registerSymbolShard(index, symbols) {
+    loadedSymbolShards[index] = symbols;
+}
+
+function getSymbolShardIndex(uniqueId) {
+    // FNV-1a over UTF-16 code units, it must be the same as GetSymbolShardIndex in GenerateSymbolDatabase.cpp
+    let hash = 2166136261;
+    for (let i = 0; i < uniqueId.length; i++) {
+        hash = Math.imul((hash ^ uniqueId.charCodeAt(i)) >>> 0, 16777619) >>> 0;
+    }
+    return hash & (symbolShards.count - 1);
+}
+
+function loadInlineReferencedSymbols(uniqueIds) {
+    const toDeclFiles = function (elementIds) {
+        return elementIds.map(function (elementId) {
+            const file = window.symbolToFiles[elementId];
+            if (file === undefined) {
+                return { elementId, file: null };
+            }
+            else if (file === null) {
+                return { elementId, file: { htmlFileName: currentHtmlFileName, displayName: '' } };
+            }
+            else {
+                return { elementId, file };
+            }
+        });
+    };
+
+    const referencedSymbols = {};
+    for (const uniqueId of uniqueIds) {
+        const symbol = window.referencedSymbols[uniqueId];
+        if (symbol !== undefined) {
+            referencedSymbols[uniqueId] = {
+                displayNameInHtml: symbol.displayNameInHtml,
+                impls: toDeclFiles(symbol.impls),
+                decls: toDeclFiles(symbol.decls)
+            };
+        }
+    }
+    return referencedSymbols;
+}
+
+async function loadReferencedSymbols(uniqueIds) {
+    if (window.referencedSymbols !== undefined && window.symbolToFiles !== undefined) {
+        return loadInlineReferencedSymbols(uniqueIds);
+    }
+
+    await loadScriptOnce('./Symbols/Shards.js');
+    await Promise.all(uniqueIds.map(function (uniqueId) {
+        return loadScriptOnce('./Symbols/' + symbolShards.files[getSymbolShardIndex(uniqueId)] + '.js');
+    }));
+
+    const referencedSymbols = {};
+    for (const uniqueId of uniqueIds) {
+        const symbols = loadedSymbolShards[getSymbolShardIndex(uniqueId)];
+        if (symbols !== undefined && symbols[uniqueId] !== undefined) {
+            referencedSymbols[uniqueId] = symbols[uniqueId];
+        }
+    }
+    return referencedSymbols;
+}
+
+function collectDecls(symbol, declFiles, labelPrefix) {
+    for (let i = 0; i < declFiles.length; i++) {
+        const declFile = declFiles[i];
+        const elementId = declFile.elementId;
+        const label = labelPrefix + '[' + i + ']';
+        if (declFile.file !== null) {
+            const file = declFile.file.htmlFileName === currentHtmlFileName ? null : declFile.file;
+            symbol.decls.push({ label, file, elementId });
+        }
+    }
+}
+
+async function jumpToSymbol(overloadResolutions, resolved) {
     closeTooltip();
+    const underElement = event.target;
     if (overloadResolutions.length === 1 && resolved.length === 1 && overloadResolutions[0] === resolved[0]) {
         overloadResolutions = [];
     }
@@ -158,31 +280,23 @@ function jumpToSymbol(overloadResolutions, resolved) {
         'Resolved': resolved
     };
     const dropdownData = [];
+    let referencedSymbols = undefined;
+    try {
+        referencedSymbols = await loadReferencedSymbols(overloadResolutions.concat(resolved));
+    }
+    catch (error) {
+        promptTooltipMessage('Failed to load the symbol database.', underElement);
+        return;
+    }
 
-    for (idsKey in packedArguments) {
+    for (const idsKey in packedArguments) {
         const idGroup = { name: idsKey, symbols: [] };
-        for (uniqueId of packedArguments[idsKey]) {
+        for (const uniqueId of packedArguments[idsKey]) {
             const referencedSymbol = referencedSymbols[uniqueId];
             if (referencedSymbol !== undefined) {
                 const symbol = { displayNameInHtml: referencedSymbol.displayNameInHtml, decls: [] };
-
-                for (i = 0; i < referencedSymbol.impls.length; i++) {
-                    const elementId = referencedSymbol.impls[i];
-                    const label = 'impl[' + i + ']';
-                    const file = symbolToFiles[elementId];
-                    if (file !== undefined) {
-                        symbol.decls.push({ label, file, elementId });
-                    }
-                }
-
-                for (i = 0; i < referencedSymbol.decls.length; i++) {
-                    const elementId = referencedSymbol.decls[i];
-                    const label = 'decl[' + i + ']';
-                    const file = symbolToFiles[elementId];
-                    if (file !== undefined) {
-                        symbol.decls.push({ label, file, elementId });
-                    }
-                }
+                collectDecls(symbol, referencedSymbol.impls, 'impl');
+                collectDecls(symbol, referencedSymbol.decls, 'decl');
 
                 if (symbol.decls.length !== 0) {
                     idGroup.symbols.push(symbol);
@@ -195,7 +309,7 @@ function jumpToSymbol(overloadResolutions, resolved) {
     }
 
     if (dropdownData.length === 0) {
-        promptTooltipMessage('The target symbol is not defined in the source code.', event.target);
+        promptTooltipMessage('The target symbol is not defined in the source code.', underElement);
         return;
     }
 
@@ -216,5 +330,5 @@ function jumpToSymbol(overloadResolutions, resolved) {
         }
     }
 
-    promptTooltipDropdownData(dropdownData, event.target);
+    promptTooltipDropdownData(dropdownData, underElement);
 }
\ No newline at end of file
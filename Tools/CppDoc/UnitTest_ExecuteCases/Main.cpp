@@ -1,18 +1,22 @@
+#include <exception>
 #include <Render.h>
 
 void IndexCppCode(
 	// input
 	FileGroupConfig& fileGroups,					// source folder (ending with FilePath::Delimiter) -> category name
 	File preprocessedFile,							// .I file generated by cl.exe
-	Ptr<RegexLexer> lexer,							// C++ lexical analyzer
+	Ptr<CppLexer> lexer,							// C++ lexical analyzer
+	SourceFileCache& sourceFiles,					// source files shared by all preprocessed files
 
 	// output
-	FilePath pathPreprocessed,						// cache: preprocessed file
-	FilePath pathInput,								// cache: compacted preprocessed file, removing all empty, space or # lines
-	FilePath pathMapping,							// cache: line mapping between pathPreprocessed and pathInput
+	FilePath pathPreprocessed,						// cache (optional): preprocessed file
+	FilePath pathInput,								// cache (optional): compacted preprocessed file, removing all empty, space or # lines
+	FilePath pathMapping,							// cache (optional): line mapping between pathPreprocessed and pathInput
+	FilePath pathReport,							// JSON report of time and counters of each phase
 	Folder folderOutput								// folder containing generated HTML files
 )
 {
+	Profiler profiler;
 	if (!folderOutput.Exists())
 	{
 		folderOutput.Create(true);
@@ -20,37 +24,33 @@ void IndexCppCode(
 
 	Console::WriteLine(preprocessedFile.GetFilePath().GetFullPath());
 	Console::WriteLine(L"    Preprocessing");
-	PreprocessedFileToCompactCodeAndMapping(
+	profiler.BeginPhase(L"Preprocessing");
+	WString preprocessed;
+	auto compacted = PreprocessedFileToCompactCodeAndMapping(
 		lexer,
 		preprocessedFile.GetFilePath(),
 		pathPreprocessed,
 		pathInput,
-		pathMapping
+		pathMapping,
+		preprocessed
 	);
 
 	Console::WriteLine(L"    Compiling");
 	IndexResult indexResult;
 	Compile(
-		lexer,
-		pathInput,
-		indexResult
+		compacted,
+		indexResult,
+		profiler
 	);
 
 	Console::WriteLine(L"    Generating HTML");
+	profiler.BeginPhase(L"Collecting");
 	auto global = Collect(
 		lexer,
-		pathPreprocessed,
-		pathInput,
-		pathMapping,
+		preprocessed,
 		indexResult
 	);
 
-	for (vint i = 0; i < global->fileLines.Keys().Count(); i++)
-	{
-		auto flr = global->fileLines.Values()[i];
-		GenerateFile(global, flr, indexResult, folderOutput.GetFilePath() / (flr->htmlFileName + L".html"));
-	}
-
 	List<WString> sourcePrefixes;
 	{
 		CopyFrom(
@@ -82,8 +82,242 @@ void IndexCppCode(
 		}
 	}
 
-	GenerateFileIndex(global, folderOutput.GetFilePath() / L"FileIndex.html", fileGroups);
-	GenerateSymbolIndex(global, indexResult, folderOutput.GetFilePath() / L"SymbolIndex.html", fileGroups);
+	// pages whose hash doesn't change since the last run are not generated again
+	profiler.BeginPhase(L"GeneratingHtml");
+	auto pathDatabase = folderOutput.GetFilePath() / L"IndexDatabase.txt";
+	IndexDatabase database;
+	ReadIndexDatabase(pathDatabase, database);
+
+	// all pages only read global and indexResult, they are generated in parallel
+	// pages referencing more symbols take longer to generate, so they are scheduled first
+	List<Ptr<FileLinesRecord>> flrs;
+	CopyFrom(
+		flrs,
+		From(global->fileLines.Values())
+			.OrderBy([](Ptr<FileLinesRecord> a, Ptr<FileLinesRecord> b)
+			{
+				return (vint)(b->refSymbols.Count() - a->refSymbols.Count());
+			})
+		);
+	// a page is recorded only after it is written, so that a failed page is generated again in the next run
+	Array<vuint64_t> pageHashes(flrs.Count());
+	Array<bool> pageRecorded(flrs.Count());
+	Array<bool> pageGenerated(flrs.Count());
+	for (vint i = 0; i < flrs.Count(); i++)
+	{
+		pageRecorded[i] = false;
+		pageGenerated[i] = false;
+	}
+
+	Semaphore semaphore;
+	semaphore.Create(0, flrs.Count() + 3);
+
+	// ThreadPoolLite discards exceptions from tasks, so the first one is kept and thrown again after all tasks finish
+	SpinLock errorLock;
+	std::exception_ptr firstError;
+	auto queueTask = [&](auto task)
+	{
+		ThreadPoolLite::QueueLambda([&, task]()
+		{
+			try
+			{
+				task();
+			}
+			catch (...)
+			{
+				SPIN_LOCK(errorLock)
+				{
+					if (!firstError) firstError = std::current_exception();
+				}
+			}
+			semaphore.Release();
+		});
+	};
+
+	queueTask([&]()
+	{
+		GenerateSymbolIndex(global, indexResult, folderOutput.GetFilePath() / L"SymbolIndex.html", fileGroups);
+	});
+
+	queueTask([&]()
+	{
+		GenerateSymbolDatabase(global, folderOutput.GetFilePath() / L"Symbols");
+	});
+
+	FOREACH_INDEXER(Ptr<FileLinesRecord>, flr, index, flrs)
+	{
+		queueTask([&, flr, index]()
+		{
+			auto pathHtml = folderOutput.GetFilePath() / (flr->htmlFileName + L".html");
+			auto hash = ComputePageHash(global, flr, indexResult, sourceFiles);
+			vint hashIndex = database.pageHashes.Keys().IndexOf(flr->htmlFileName);
+
+			bool generating = hashIndex == -1 || database.pageHashes.Values()[hashIndex] != hash || !File(pathHtml).Exists();
+			if (generating)
+			{
+				GenerateFile(global, flr, indexResult, sourceFiles, pathHtml);
+			}
+			pageHashes[index] = hash;
+			pageGenerated[index] = generating;
+			pageRecorded[index] = true;
+		});
+	}
+
+	queueTask([&]()
+	{
+		GenerateFileIndex(global, folderOutput.GetFilePath() / L"FileIndex.html", fileGroups);
+	});
+
+	for (vint i = 0; i < flrs.Count() + 3; i++)
+	{
+		semaphore.Wait();
+	}
+
+	// remove pages for files that no longer exist in the input
+	for (vint i = 0; i < database.pageHashes.Count(); i++)
+	{
+		auto htmlFileName = database.pageHashes.Keys()[i];
+		if (!global->htmlFileNames.Contains(htmlFileName))
+		{
+			File(folderOutput.GetFilePath() / (htmlFileName + L".html")).Delete();
+		}
+	}
+
+	database.pageHashes.Clear();
+	vint generatedCount = 0;
+	for (vint i = 0; i < flrs.Count(); i++)
+	{
+		if (pageRecorded[i]) database.pageHashes.Add(flrs[i]->htmlFileName, pageHashes[i]);
+		if (pageGenerated[i]) generatedCount++;
+	}
+	WriteIndexDatabase(pathDatabase, database);
+	Console::WriteLine(L"    Generated " + itow(generatedCount) + L" of " + itow(flrs.Count()) + L" source pages");
+
+	if (firstError)
+	{
+		std::rethrow_exception(firstError);
+	}
+
+	profiler.EndPhase();
+	profiler.WriteReport(pathReport);
+}
+
+/***********************************************************************
+BenchmarkLexers
+***********************************************************************/
+
+bool IsSameToken(const RegexToken& a, const RegexToken& b)
+{
+	return a == b
+		&& a.start == b.start
+		&& a.completeToken == b.completeToken
+		&& a.rowStart == b.rowStart
+		&& a.columnStart == b.columnStart
+		&& a.rowEnd == b.rowEnd
+		&& a.columnEnd == b.columnEnd
+		;
+}
+
+void BenchmarkLexers(File preprocessedFile)
+{
+	Console::WriteLine(L"Lexing " + preprocessedFile.GetFilePath().GetFullPath());
+	auto input = preprocessedFile.ReadAllTextByBom();
+
+	auto regexBegin = DateTime::UtcTime().totalMilliseconds;
+	auto regexLexer = CreateCppRegexLexer();
+	auto regexBuilt = DateTime::UtcTime().totalMilliseconds;
+	List<RegexToken> regexTokens;
+	regexLexer->Parse(input).ReadToEnd(regexTokens);
+	auto regexEnd = DateTime::UtcTime().totalMilliseconds;
+
+	auto cppBegin = DateTime::UtcTime().totalMilliseconds;
+	auto cppLexer = CreateCppLexer();
+	List<RegexToken> cppTokens;
+	cppLexer->Parse(input, cppTokens);
+	auto cppEnd = DateTime::UtcTime().totalMilliseconds;
+
+	Console::WriteLine(L"    RegexLexer: " + u64tow(regexBuilt - regexBegin) + L" ms to build, " + u64tow(regexEnd - regexBuilt) + L" ms to lex " + itow(regexTokens.Count()) + L" tokens");
+	Console::WriteLine(L"    CppLexer: " + u64tow(cppEnd - cppBegin) + L" ms to lex " + itow(cppTokens.Count()) + L" tokens");
+
+	for (vint i = 0; i < regexTokens.Count() && i < cppTokens.Count(); i++)
+	{
+		if (!IsSameToken(regexTokens[i], cppTokens[i]))
+		{
+			Console::WriteLine(L"    Different token at row " + itow(regexTokens[i].rowStart + 1) + L", column " + itow(regexTokens[i].columnStart + 1));
+			return;
+		}
+	}
+	if (regexTokens.Count() != cppTokens.Count())
+	{
+		Console::WriteLine(L"    Different number of tokens");
+	}
+}
+
+/***********************************************************************
+BenchmarkOverloads
+***********************************************************************/
+
+void BenchmarkOverloads(Ptr<CppLexer> lexer, vint count)
+{
+	Console::WriteLine(L"Resolving calls to " + itow(count) + L" overloads");
+
+	WString input;
+	for (vint i = 0; i < count; i++)
+	{
+		input += L"struct S" + itow(i) + L"{}; S" + itow(i) + L"* F(S" + itow(i) + L");\r\n";
+	}
+
+	CppTokenReader reader(lexer, input);
+	auto cursor = reader.GetFirstToken();
+	ParsingArguments pa(new Symbol(symbol_component::SymbolCategory::Normal), ITsysAlloc::Create(), nullptr);
+	auto program = ParseProgram(pa, cursor);
+	EvaluateProgram(pa, program);
+
+	auto resolveBegin = DateTime::UtcTime().totalMilliseconds;
+	for (vint i = 0; i < count; i++)
+	{
+		CppTokenReader callReader(lexer, L"F(S" + itow(i) + L"())");
+		auto callCursor = callReader.GetFirstToken();
+		ExprTsysList types;
+		ExprToTsysNoVta(pa, ParseExpr(pa, pea_Full(), callCursor), types);
+	}
+	auto resolveEnd = DateTime::UtcTime().totalMilliseconds;
+	Console::WriteLine(L"    " + itow(count) + L" calls: " + u64tow(resolveEnd - resolveBegin) + L" ms");
+
+	// all overloads of F are candidates, adding them without duplication is what ExprTsysList is for
+	ExprTsysList candidates;
+	{
+		CppTokenReader nameReader(lexer, L"F");
+		auto nameCursor = nameReader.GetFirstToken();
+		ExprToTsysNoVta(pa, ParseExpr(pa, pea_Full(), nameCursor), candidates);
+	}
+
+	const vint rounds = 100;
+	auto hashedBegin = DateTime::UtcTime().totalMilliseconds;
+	for (vint round = 0; round < rounds; round++)
+	{
+		ExprTsysList items;
+		for (vint i = 0; i < candidates.Count(); i++)
+		{
+			if (!items.Contains(candidates[i])) items.Add(candidates[i]);
+		}
+	}
+	auto hashedEnd = DateTime::UtcTime().totalMilliseconds;
+
+	auto linearBegin = DateTime::UtcTime().totalMilliseconds;
+	for (vint round = 0; round < rounds; round++)
+	{
+		List<ExprTsysItem> items;
+		for (vint i = 0; i < candidates.Count(); i++)
+		{
+			if (!items.Contains(candidates[i])) items.Add(candidates[i]);
+		}
+	}
+	auto linearEnd = DateTime::UtcTime().totalMilliseconds;
+
+	Console::WriteLine(L"    Adding " + itow(candidates.Count()) + L" candidates " + itow(rounds) + L" times:");
+	Console::WriteLine(L"        ExprTsysList: " + u64tow(hashedEnd - hashedBegin) + L" ms");
+	Console::WriteLine(L"        List + Contains: " + u64tow(linearEnd - linearBegin) + L" ms");
 }
 
 /***********************************************************************
@@ -91,24 +325,34 @@ Main
 
 Set root folder which contains UnitTest_Cases.vcxproj
 Open http://127.0.0.1:8080/Calculator.i.Output/FileIndex.html
+Pass --benchmark-lexers to compare RegexLexer and CppLexer before generating
+Pass --benchmark-overloads to compare ExprTsysList and List + Contains in overload resolution before generating
 ***********************************************************************/
 
-int main()
+int main(int argc, char* argv[])
 {
 	List<File> preprocessedFiles;
 	preprocessedFiles.Add(File(L"../UnitTest_Cases/Calculator.i"));
 	preprocessedFiles.Add(File(L"../UnitTest_Cases/STL.i"));
 
-	Console::WriteLine(L"Cleaning ...");
-	FOREACH(File, file, preprocessedFiles)
+	auto lexer = CreateCppLexer();
+	for (int i = 1; i < argc; i++)
 	{
-		Folder folderOutput(file.GetFilePath().GetFullPath() + L".Output");
-		if (folderOutput.Exists())
+		if (strcmp(argv[i], "--benchmark-lexers") == 0)
 		{
-			folderOutput.Delete(true);
+			FOREACH(File, file, preprocessedFiles)
+			{
+				BenchmarkLexers(file);
+			}
+		}
+		else if (strcmp(argv[i], "--benchmark-overloads") == 0)
+		{
+			BenchmarkOverloads(lexer, 300);
 		}
 	}
-	auto lexer = CreateCppLexer();
+
+	// output folders are kept, so that unchanged pages are not generated again
+	SourceFileCache sourceFiles;
 
 	FOREACH(File, file, preprocessedFiles)
 	{
@@ -116,10 +360,11 @@ int main()
 		auto pathPreprocessed = folderOutput.GetFilePath() / L"Preprocessed.cpp";
 		auto pathInput = folderOutput.GetFilePath() / L"Input.cpp";
 		auto pathMapping = folderOutput.GetFilePath() / L"Mapping.bin";
+		FilePath pathReport = file.GetFilePath().GetFullPath() + L".Profile.json";
 
 		FileGroupConfig fileGroups;
 		fileGroups.Add({ file.GetFilePath().GetFolder().GetFullPath() + FilePath::Delimiter, L"Source Code of this Project" });
-		IndexCppCode(fileGroups, file, lexer, pathPreprocessed, pathInput, pathMapping, folderOutput);
+		IndexCppCode(fileGroups, file, lexer, sourceFiles, pathPreprocessed, pathInput, pathMapping, pathReport, folderOutput);
 	}
 
 	//{